@@ -0,0 +1,62 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Dual core sampling on ESP32.
+  A task pinned to core 0 samples GPIO34 at 1 kHz and queues the values
+  with pushFromISR(), loop() on core 1 draws and sends the frames.
+  The sampler never waits for the display, and as only loop() changes
+  the graph every frame shows one consistent range and time base.
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //full buffer
+
+U8g2GraphingT<int16_t> graph(&u8g2);
+
+volatile uint32_t dropped = 0;
+
+//Sampler task, only reads the ADC and queues the sample.
+void sampler(void *arg) {
+  TickType_t wake = xTaskGetTickCount();
+  for (;;) {
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(1));
+    if (!graph.pushFromISR(analogRead(34), micros())) {
+      dropped++;
+    }
+  }
+}
+
+void setup() {
+
+  u8g2.begin();
+  u8g2.setBusClock(400000);
+  u8g2.setFont(u8g2_font_tom_thumb_4x6_tf);
+  u8g2.setFontMode(1);
+  u8g2.setDrawColor(2);
+
+  graph.begin(0, 9, 127, 63);
+  graph.rangeSet(true, 0, 4096);
+
+  //The queue has to hold the samples of one full screen refresh, a full buffer
+  //at 400 kHz I2C takes about 25ms. On ESP32 it can hold up to 4096 entries.
+  graph.queueSet(256);
+
+  xTaskCreatePinnedToCore(sampler, "sampler", 2048, nullptr, 1, nullptr, 0);
+}
+
+void loop() {
+  u8g2.clearBuffer();
+  u8g2.setCursor(4, 7);
+  u8g2.print("Dual core");
+  u8g2.setCursor(64, 7);
+  u8g2.print(dropped);
+
+  //Drains the queued samples, then draws the graph.
+  graph.displayGraph();
+  u8g2.sendBuffer();
+}
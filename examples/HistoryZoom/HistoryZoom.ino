@@ -0,0 +1,94 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Deep history with zoom and pan.
+  The graph keeps the last 8192 samples of A0, every few seconds
+  the view zooms out, pans back in time, and returns to the live graph.
+  Needs more RAM than Uno (ESP32, ESP8266, SAMD...), on ESP32 with PSRAM
+  the history is placed in PSRAM.
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //full buffer
+
+U8g2GraphingT<int16_t> graph(&u8g2);
+
+const uint32_t historyLen = 8192;
+
+uint32_t preMil = 0;
+int state = 0;
+bool refresh = true;
+
+void setup() {
+
+  pinMode(A0, INPUT);
+
+  u8g2.begin();
+  u8g2.setFont(u8g2_font_tom_thumb_4x6_tf);
+  u8g2.setFontMode(1);
+  u8g2.setDrawColor(2);
+
+  graph.begin(0, 9, 127, 63);
+
+  //Only the new columns are drawn while the range stays the same.
+  graph.scrollSet(true);
+
+  //The history is set after .begin, historyBytes() gives the size
+  //of the samples plus their min/max pyramid.
+#if defined(BOARD_HAS_PSRAM)
+  graph.historySet(ps_malloc(graph.historyBytes(historyLen)), graph.historyBytes(historyLen));
+#else
+  graph.historySet(historyLen);
+#endif
+
+  //On small RAM boards a packed history of a few hundred bytes holds
+  //a slowly changing signal at about a byte per sample or less:
+  //graph.historyPackedSet(512);
+}
+
+void loop() {
+  graph.inputValue(analogRead(A0));
+
+  //Cycle through the views every 5s.
+  if (millis() - preMil >= 5000) {
+    preMil = millis();
+    refresh = true;
+    state = (state + 1) % 4;
+    switch (state) {
+      case 0:
+        //Back to the live graph.
+        graph.setView(0, 0);
+        break;
+      case 1:
+        //Follow the newest sample, 16 samples per column.
+        graph.setView(0, 16);
+        break;
+      case 2:
+        //Zoom out on the whole history.
+        graph.setView(0, graph.getHistoryLen() / graph.getDataLen() + 1);
+        break;
+      case 3:
+        //Pan back 2000 samples, 4 samples per column, the view stays there.
+        graph.setView(2000, 4);
+        break;
+    }
+  }
+
+  //The graph keeps its area of the buffer between frames, only the title row is cleared.
+  u8g2.setDrawColor(0);
+  u8g2.drawBox(0, 0, 128, 9);
+  u8g2.setDrawColor(1);
+  u8g2.setCursor(4, 7);
+  u8g2.print("View ");
+  u8g2.print(state);
+  graph.displayGraph();
+
+  //Only the changed tiles of the graph are sent, the whole screen when the title changes.
+  graph.flush(refresh);
+  refresh = false;
+}
@@ -0,0 +1,73 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Compare the float and fixed-point projection on the current board.
+  Every input forces a full reprojection by switching between two manual ranges,
+  the result is printed to Serial as microseconds per column.
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display
+
+U8G2_SSD1306_128X64_NONAME_1_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //page buffer
+
+U8g2GraphingT<int16_t> graphInt(&u8g2);
+U8g2Graphing graphFloat(&u8g2);
+
+const int rounds = 50;
+
+//Forward declaration
+template <typename T> float benchmark(T &graph, bool fixedpoint);
+
+void setup() {
+  Serial.begin(115200);
+
+  u8g2.begin();
+
+  graphInt.begin(0, 9, 127, 63);
+  graphFloat.begin(0, 9, 127, 63);
+
+  //Fill the graphs once so every column holds a real value.
+  for (int i = 0; i <= graphInt.getDataLen() + 2; i++) {
+    graphInt.inputValue(analogRead(A0));
+    graphFloat.inputValue(analogRead(A0) / 10.0f);
+  }
+}
+
+void loop() {
+  Serial.print("int16 float math: ");
+  Serial.print(benchmark(graphInt, false), 3);
+  Serial.print(" us/col, fixed: ");
+  Serial.print(benchmark(graphInt, true), 3);
+  Serial.println(" us/col");
+
+  Serial.print("float float math: ");
+  Serial.print(benchmark(graphFloat, false), 3);
+  Serial.print(" us/col, fixed: ");
+  Serial.print(benchmark(graphFloat, true), 3);
+  Serial.println(" us/col");
+
+  delay(2000);
+}
+
+//Time the full reprojections, the graph is stopped so only the projection runs.
+template <typename T> float benchmark(T &graph, bool fixedpoint) {
+  graph.projectionSet(fixedpoint);
+  graph.stop();
+
+  uint32_t reproj = graph.getReprojectCount();
+  uint32_t start = micros();
+  for (int i = 0; i < rounds; i++) {
+    graph.rangeSet(true, 0, (i & 1) ? 1024 : 1000);
+    graph.inputValue(0);
+  }
+  uint32_t elapsed = micros() - start;
+  reproj = graph.getReprojectCount() - reproj;
+
+  graph.start();
+  graph.rangeSet(false);
+  return (float)elapsed / (reproj * (graph.getDataLen() + 2));
+}
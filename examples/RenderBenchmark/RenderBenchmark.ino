@@ -0,0 +1,148 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Benchmark and golden frame check of the input and render paths.
+  Every case feeds the same generated signal with fixed 1ms time stamps,
+  then prints the time per input and per frame, for a full buffer and
+  a page buffer display, and the CRC32 of the rendered frame.
+  The CRC of a case only changes when its pixels change, so the output
+  of two library versions can be compared to check a change is pixel exact.
+  The frames are rendered into the buffers only and never sent.
+  Needs more RAM than Uno (ESP32, ESP8266, SAMD...).
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display,
+//one full buffer and one page buffer driver of the same display.
+
+U8G2_SSD1306_128X64_NONAME_F_HW_I2C full(U8G2_R0, U8X8_PIN_NONE); //full buffer
+U8G2_SSD1306_128X64_NONAME_1_HW_I2C page(U8G2_R0, U8X8_PIN_NONE); //page buffer
+
+U8g2GraphingT<int16_t> int16Full(&full), int16Page(&page);
+U8g2GraphingT<uint8_t> uint8Full(&full), uint8Page(&page);
+U8g2Graphing floatFull(&full), floatPage(&page);
+
+const int samples = 300;
+const int frames = 20;
+
+//Forward declaration
+template <typename T> void runCase(const char *name, U8g2GraphingT<T> &graphFull, U8g2GraphingT<T> &graphPage, uint16_t tox);
+
+void setup() {
+  Serial.begin(115200);
+
+  full.begin();
+  page.begin();
+  full.setFont(u8g2_font_tom_thumb_4x6_tf);
+  page.setFont(u8g2_font_tom_thumb_4x6_tf);
+}
+
+void loop() {
+  //Graphs 61 and 128 pixels wide.
+  for (uint16_t tox = 60; tox <= 127; tox += 67) {
+    runCase("int16", int16Full, int16Page, tox);
+    runCase("uint8", uint8Full, uint8Page, tox);
+    runCase("float", floatFull, floatPage, tox);
+  }
+  Serial.println();
+
+  delay(5000);
+}
+
+//Generated test signal, a sine with a spike every 37 samples.
+float signal(uint16_t i) {
+  return sin(i * 0.07) * 100 + ((i % 37 == 0) ? 40 : 0) + 105;
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+//Render one frame into the full buffer, returns its CRC.
+template <typename G> uint32_t renderFull(G &graph) {
+  full.clearBuffer();
+  graph.displayGraph();
+  return crc32(0, full.getBufferPtr(), 8 * full.getBufferTileHeight() * full.getBufferTileWidth());
+}
+
+//Render one frame page by page, returns the CRC of the pages in order,
+//the same as the CRC of the full buffer frame.
+template <typename G> uint32_t renderPage(G &graph) {
+  uint32_t crc = 0;
+  for (uint8_t row = 0; row < page.getDisplayHeight() / 8; row++) {
+    page.setBufferCurrTileRow(row);
+    page.clearBuffer();
+    graph.displayGraph();
+    crc = crc32(crc, page.getBufferPtr(), 8 * page.getBufferTileWidth());
+  }
+  return crc;
+}
+
+//Feed the signal with fixed time stamps so the frames only depend on the library.
+template <typename G> void feed(G &graph, uint16_t from, uint16_t n) {
+  for (uint16_t i = from; i < from + n; i++) {
+    graph.inputValue(signal(i));
+  }
+}
+
+template <typename T> void runCase(const char *name, U8g2GraphingT<T> &graphFull, U8g2GraphingT<T> &graphPage, uint16_t tox) {
+  graphFull.begin(0, 9, tox, 63);
+  graphPage.begin(0, 9, tox, 63);
+  graphFull.pointerSet(true, 15);
+  graphPage.pointerSet(true, 15);
+
+  //Input, time stamps from micros().
+  uint32_t start = micros();
+  feed(graphFull, 0, samples);
+  uint32_t inputTime = micros() - start;
+
+  //Golden frame, the whole signal as one block 1ms apart. Only the samples
+  //of one block are spaced by the given interval, so a block per sample
+  //would stamp the columns with the time between the calls.
+  static T block[samples];
+  for (uint16_t i = 0; i < samples; i++) {
+    block[i] = signal(i);
+  }
+  graphFull.clearData();
+  graphFull.inputValues(block, samples, 1000);
+  graphPage.inputValues(block, samples, 1000);
+  uint32_t crcFull = renderFull(graphFull);
+  uint32_t crcPage = renderPage(graphPage);
+
+  //Render, one new sample per frame.
+  uint32_t fullTime = 0;
+  uint32_t pageTime = 0;
+  for (int f = 0; f < frames; f++) {
+    feed(graphFull, samples + f, 1);
+    feed(graphPage, samples + f, 1);
+    start = micros();
+    renderFull(graphFull);
+    fullTime += micros() - start;
+    start = micros();
+    renderPage(graphPage);
+    pageTime += micros() - start;
+  }
+
+  Serial.print(name);
+  Serial.print(" w");
+  Serial.print(graphFull.getDataLen());
+  Serial.print(" input ");
+  Serial.print((float)inputTime / samples, 2);
+  Serial.print(" us/sample, full ");
+  Serial.print(fullTime / frames);
+  Serial.print(" us/frame, page ");
+  Serial.print(pageTime / frames);
+  Serial.print(" us/frame, crc ");
+  Serial.print(crcFull, HEX);
+  Serial.println((crcPage == crcFull) ? " page ok" : " PAGE MISMATCH");
+}
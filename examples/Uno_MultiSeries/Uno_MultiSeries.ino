@@ -0,0 +1,71 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Three sensors on one graph, sharing the time base, the range and the axes.
+  A0, A1 and A2 are drawn solid, dotted and dashed.
+  uint8_t samples keep the three series small enough for Uno.
+  Send 'c' (CSV) or 'b' (binary) over serial to export the columns on the graph,
+  sent a few rows per loop so the sampling and the display keep running.
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display
+
+U8G2_SSD1306_128X64_NONAME_1_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //page buffer
+
+U8g2GraphingT<uint8_t> graph(&u8g2);
+
+void setup() {
+
+  pinMode(A0, INPUT);
+  pinMode(A1, INPUT);
+  pinMode(A2, INPUT);
+
+  Serial.begin(115200);
+
+  u8g2.begin();
+  u8g2.setFont(u8g2_font_tom_thumb_4x6_tf);
+  u8g2.setFontMode(1);
+  u8g2.setDrawColor(2);
+
+  graph.begin(0, 9, 127, 63);
+
+  //Series are set after .begin, the styles default to solid, dotted and dashed.
+  graph.seriesSet(3);
+  graph.seriesStyle(0, U8G2GRAPH_SOLID);
+  graph.seriesStyle(1, U8G2GRAPH_DOTTED);
+  graph.seriesStyle(2, U8G2GRAPH_DASHED);
+
+  graph.intervalSet(20);
+}
+
+void loop() {
+  //One row holds one value per series.
+  uint8_t row[3];
+  row[0] = analogRead(A0) >> 2;
+  row[1] = analogRead(A1) >> 2;
+  row[2] = analogRead(A2) >> 2;
+  graph.inputSeries(row);
+
+  //Start an export on request, then send what fits in the serial buffer on every loop.
+  if (Serial.available()) {
+    char c = Serial.read();
+    if (c == 'c') {
+      graph.exportStart(U8G2GRAPH_EXPORT_CSV);
+    } else if (c == 'b') {
+      graph.exportStart(U8G2GRAPH_EXPORT_BINARY);
+    }
+  }
+  graph.exportData(Serial);
+
+  u8g2.firstPage();
+  do {
+    u8g2.setCursor(4, 7);
+    u8g2.print("A0 A1 A2");
+
+    graph.displayGraph();
+  } while (u8g2.nextPage());
+}
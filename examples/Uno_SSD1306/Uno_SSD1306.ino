@@ -15,7 +15,13 @@
 U8G2_SSD1306_128X64_NONAME_1_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //page buffer
 
 //Constructor, takes a reference to the current instance of U8g2 display.
-U8g2Graphing graph(&u8g2);
+//The template argument is the sample type stored for every column,
+//int16_t keeps the RAM usage low enough for Uno, use int8_t or uint8_t for even less.
+//U8g2Graphing is the float graph, same as U8g2GraphingT<float>.
+//The second argument reserves the storage for 107 columns (127 - 0 - 20) inside the object,
+//so the RAM use shows up at compile time and .begin never allocates.
+//Without it the storage is allocated on the heap by .begin.
+U8g2GraphingT<int16_t, 107> graph(&u8g2);
 
 float result = 0;
 float _ndx = 0;
@@ -43,9 +49,10 @@ void setup() {
   u8g2.setDrawColor(2);
 
   //There are 2 method to initiate the graph, .beginInt and .begin
-  //.beginInt is used for integer data and lower RAM allocation.
-  //.begin is used for floating point data but higher RAM allocation.
-  //Using .begin on Uno will cause glitch and crash as it'll be over the RAM limit.
+  //.beginInt treats the data as integer, even on a float graph.
+  //.begin treats the data as the sample type of the graph (floating point on U8g2Graphing).
+  //The RAM use depends on the sample type and is reserved at compile time here,
+  //a float graph on Uno would be over the RAM limit.
   //The arguments for the function is (from x, from y, to x, to y) in pixels.
   graph.beginInt(0, 9, 127, 63);
 
@@ -142,7 +149,8 @@ void realtimeGraph() {
 
 
 //In this example, we first sample all the data from the ADC to the graph points,
-//and then display the graph. Kind of like normal mode on the oscilloscope.
+//and then display the graph. Kind of like single shot mode on the oscilloscope,
+//the trigger lines up every capture of a repetitive waveform.
 
 void preloadGraph() {
   //Initialize setting
@@ -158,10 +166,22 @@ void preloadGraph() {
     //and set the min max range manually.
     graph.rangeSet(true, 0, 1024);
 
-    //For loop to input the data to the graph as many as the total data points available
-    //using .getDataLen() function. Add 2 to avoid glitch on the leftmost graph.
-    for (int i = 0; i <= graph.getDataLen() + 2; i++) {
-      graph.inputValue(analogRead(A0));
+    //Trigger on a rising edge through 512 with 20 counts of hysteresis,
+    //the first quarter of the graph shows the samples before the trigger.
+    //This also arms the trigger again after the previous capture.
+    graph.triggerSet(U8G2GRAPH_TRIGGER_RISING, 512, 20, 0.25);
+
+    //Sample the ADC in blocks and hand each block to the graph with .inputValues,
+    //until the capture around the trigger is complete (.isTriggered()),
+    //or show the last samples if there was no trigger for 100ms.
+    //The sample interval of the block is measured here, pass it in µs if it is known.
+    int16_t block[16];
+    uint32_t armed = millis();
+    while (!graph.isTriggered() && millis() - armed < 100) {
+      for (uint8_t j = 0; j < 16; j++) {
+        block[j] = analogRead(A0);
+      }
+      graph.inputValues(block, 16);
     }
 
     u8g2.firstPage();
@@ -173,6 +193,7 @@ void preloadGraph() {
       graph.displayGraph();
     } while (u8g2.nextPage());
   }
+  graph.triggerSet(U8G2GRAPH_TRIGGER_OFF, 0);
   graph.clearData();
 
   u8g2.firstPage();
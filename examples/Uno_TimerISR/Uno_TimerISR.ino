@@ -0,0 +1,66 @@
+/*
+  Simple graphing function for U8g2 display library.
+
+  Fixed rate sampling from a timer interrupt.
+  Timer1 samples A0 at 2 kHz and queues the value with pushFromISR(),
+  the graph drains the queue on every displayGraph(), so the slow I2C
+  page transfers no longer limit or disturb the sample rate.
+  This sketch uses the AVR Timer1 registers (Uno, Nano, Mega).
+*/
+
+#include <U8g2lib.h>
+#include <Wire.h>
+#include <U8g2Graphing.h>
+
+//This example is using SSD1306 128x64 I2C monochrome OLED display
+
+U8G2_SSD1306_128X64_NONAME_1_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE); //page buffer
+
+U8g2GraphingT<int16_t> graph(&u8g2);
+
+volatile uint16_t dropped = 0;
+
+//Timer1 compare interrupt, only reads the ADC and queues the sample.
+ISR(TIMER1_COMPA_vect) {
+  if (!graph.pushFromISR(analogRead(A0), micros())) {
+    dropped++;
+  }
+}
+
+void setup() {
+
+  pinMode(A0, INPUT);
+
+  u8g2.begin();
+  u8g2.setFont(u8g2_font_tom_thumb_4x6_tf);
+  u8g2.setFontMode(1);
+  u8g2.setDrawColor(2);
+
+  graph.begin(0, 9, 127, 63);
+  graph.rangeSet(true, 0, 1024);
+
+  //The queue has to hold the samples of one full screen refresh,
+  //a page buffer refresh over I2C takes about 30ms, 60 samples at 2 kHz.
+  graph.queueSet(128);
+
+  //Timer1 CTC mode, 16MHz / 8 / 1000 = 2 kHz.
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | _BV(CS11);
+  OCR1A = 999;
+  TIMSK1 = _BV(OCIE1A);
+  interrupts();
+}
+
+void loop() {
+  u8g2.firstPage();
+  do {
+    u8g2.setCursor(4, 7);
+    u8g2.print("Timer ISR");
+    u8g2.setCursor(64, 7);
+    u8g2.print(dropped);
+
+    //Drains the queued samples on the first page, then draws the graph.
+    graph.displayGraph();
+  } while (u8g2.nextPage());
+}
@@ -9,160 +9,128 @@
 
 //Constructor, takes pointer to existing U8g2 instance.
 //========================================================================
-U8g2Graphing::U8g2Graphing(U8G2 *u8g) : u8g2(u8g), graphstart(true) {}
+U8g2GraphingBase::U8g2GraphingBase(U8G2 *u8g) : u8g2(u8g) {}
 
-//Deconstructor, delete all data.
-//========================================================================
-U8g2Graphing::~U8g2Graphing() {
-    resetArray();
-}
-
-void U8g2Graphing::resetArray() {
-    if (graph) {
-        for (uint16_t i = 0; i < grwidth; i++) {
-            delete [] graph[i];
-        }
-        delete [] graph;
-    }
-    if (dataset) {
-        delete [] dataset;
+U8g2GraphingBase::~U8g2GraphingBase() {
+    if (tileheap) {
+        delete [] tilesum;
     }
-    if (graphInt) {
-        for (uint16_t i = 0; i < grwidth; i++) {
-            delete [] graphInt[i];
-        }
-        delete [] graphInt;
-    }
-    if (datasetInt) {
-        delete [] datasetInt;
-    }
-    graph = nullptr;
-    graphInt = nullptr;
-    dataset = nullptr;
-    datasetInt = nullptr;
-    graphstart = true;
 }
 
-//Floating point buffer initializer, define the position and size of the graph,
-//then set the buffers to heap memory.
+//Define the position and size of the graph.
 //========================================================================
-void U8g2Graphing::begin(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy) {
-    if (!graphstart) {
-        resetArray();
-    }
+void U8g2GraphingBase::setGeometry(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy) {
     this->fromx = fromx;
     this->fromy = fromy;
     this->tox = tox;
+    endx = tox;
     this->toy = toy;
     grwidth = tox - fromx - 20;
-    if (graphstart) {
-        graph = new uint16_t*[grwidth];
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graph[i] = new uint16_t[2];
-        }
-        dataset = new float[grwidth];
-        for (uint16_t i = 0; i < grwidth; i++) {
-            dataset[i] = 0;
-        }
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graph[i][0] = fromx;
-            graph[i][1] = toy;
-        }
-        graphstart = false;
-    }
-    activate = true;
-    xaxis = true;
-    pointer = false;
-    dotted = false;
-    autorange = true;
-    isFloat = true;
-    curmil = 0;
-    ppt = 0;
-    _pointndx = 0;
-    intvl = 0;
-    spd = 1;
-    isTypeInt = false;
+    tilevalid = false;
 }
 
-//Integer buffer initializer, define the position and size of the graph,
-//then set the buffers to heap memory.
+//Reset every setting to its default, called from begin().
 //========================================================================
-void U8g2Graphing::beginInt(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy) {
-    if (!graphstart) {
-        resetArray();
-    }
-    this->fromx = fromx;
-    this->fromy = fromy;
-    this->tox = tox;
-    this->toy = toy;
-    grwidth = tox - fromx - 20;
-    if (graphstart) {
-
-        graphInt = new uint8_t*[grwidth];
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graphInt[i] = new uint8_t[2];
-        }
-        datasetInt = new int[grwidth];
-
-        for (uint16_t i = 0; i < grwidth; i++) {
-            datasetInt[i] = 0;
-        }
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graphInt[i][0] = fromx;
-            graphInt[i][1] = toy;
-        }
-        graphstart = false;
-    }
+void U8g2GraphingBase::resetState(bool isTypeInt) {
+    ndx = 0;
+    count = 0;
     activate = true;
     xaxis = true;
     pointer = false;
-    dotted = false;
+    series = 1;
+    styles[0] = U8G2GRAPH_SOLID;
+    styles[1] = U8G2GRAPH_DOTTED;
+    styles[2] = U8G2GRAPH_DASHED;
+    styles[3] = U8G2GRAPH_SOLID;
     autorange = true;
-    isFloat = false;
     curmil = 0;
-    ppt = 0;
+    coltime = 0;
+    blockstep = 0;
+    timeaxis = false;
     _pointndx = 0;
     intvl = 0;
     spd = 1;
-    isTypeInt = true;
+    decim = 1;
+    decimfill = 0;
+    envelope = false;
+    fixedpoint = false;
+    meanline = false;
+    sigmaband = false;
+    scroll = false;
+    scrollvalid = false;
+    labelvalid = false;
+    ptrreadout.valid = false;
+    trigedge = U8G2GRAPH_TRIGGER_OFF;
+    exporting = false;
+    trigfrozen = false;
+    trigfired = false;
+    for (uint8_t m = 0; m < U8G2GRAPH_MAX_MARKERS; m++) {
+        markertype[m] = U8G2GRAPH_MARKER_OFF;
+        markerreadout[m].valid = false;
+    }
+    this->isTypeInt = isTypeInt;
+}
+
+//Reset the sliding window min/max queues, the whole ring holds zeros
+//at this point so the newest slot alone represents both extremes.
+//========================================================================
+void U8g2GraphingBase::resetWindow() {
+    minq[0] = ndx;
+    maxq[0] = ndx;
+    minhead = 0;
+    maxhead = 0;
+    minlen = 1;
+    maxlen = 1;
 }
 
 //Start the graph sampling using function.
 //========================================================================
-void U8g2Graphing::start() {
+void U8g2GraphingBase::start() {
     activate = true;
 }
 
 //Stop the graph sampling using function.
 //========================================================================
-void U8g2Graphing::stop() {
+void U8g2GraphingBase::stop() {
     activate = false;
 }
 
 //Control the start-stop of graph sampling using external variable
 //========================================================================
-void U8g2Graphing::startSampling(bool sample) {
+void U8g2GraphingBase::startSampling(bool sample) {
     activate = sample;
 }
 
 //Set the sampling interval,
 //useful if you don't want to use delay function.
 //========================================================================
-void U8g2Graphing::intervalSet(uint32_t intvl) {
+void U8g2GraphingBase::intervalSet(uint32_t intvl) {
     this->intvl = intvl;
 }
 
-//Set the display style, with or without x axis and dotted or line style.
+//Set the display style, with or without x axis and dotted or line style,
+//the style applies to the first series.
 //========================================================================
-void U8g2Graphing::displaySet(bool xaxis, bool dotted) {
+void U8g2GraphingBase::displaySet(bool xaxis, bool dotted) {
     this->xaxis = xaxis;
-    this->dotted = dotted;
+    styles[0] = dotted ? U8G2GRAPH_DOTTED : U8G2GRAPH_SOLID;
+    scrollvalid = false;
+}
+
+//Set the line style of a series, solid, dotted (one pixel per column)
+//or dashed (4 columns on, 4 columns off).
+//========================================================================
+void U8g2GraphingBase::seriesStyle(uint8_t index, U8g2GraphingStyle style) {
+    if (index < U8G2GRAPH_MAX_SERIES) {
+        styles[index] = style;
+    }
+    scrollvalid = false;
 }
 
 //Set the pointer display, and set the pointer index,
 //the index is mapped from 0 (rightmost data) to 500 (leftmost data).
 //========================================================================
-void U8g2Graphing::pointerSet(bool pointer, uint16_t pointndx) {
+void U8g2GraphingBase::pointerSet(bool pointer, uint16_t pointndx) {
     this->pointer = pointer;
     _pointndx = map(pointndx, 0, 500, 0, grwidth - 2);
 }
@@ -170,521 +138,1060 @@ void U8g2Graphing::pointerSet(bool pointer, uint16_t pointndx) {
 //Set the pointer display, and set the pointer index,
 //the index is an actual graph index, not mapped.
 //========================================================================
-void U8g2Graphing::pointerSetI(bool pointer, uint16_t pointndx) {
+void U8g2GraphingBase::pointerSetI(bool pointer, uint16_t pointndx) {
     this->pointer = pointer;
     uint16_t maxndx = getDataLen();
     _pointndx = constrain(pointndx, 0, maxndx);
 }
 
+//Set a marker, up to U8G2GRAPH_MAX_MARKERS. A cursor shows the value of the column
+//position columns left of the newest one (as pointerSetI()), a level draws a dotted
+//line with its value at position, min and max follow the column holding the
+//current data min or max. U8G2GRAPH_MARKER_OFF removes the marker.
+//========================================================================
+void U8g2GraphingBase::markerSet(uint8_t index, U8g2GraphingMarker type, float position) {
+    if (index >= U8G2GRAPH_MAX_MARKERS) {
+        return;
+    }
+    markertype[index] = type;
+    markerpos[index] = (type == U8G2GRAPH_MARKER_CURSOR) ? constrain(position, 0, getDataLen()) : position;
+    markerreadout[index].valid = false;
+    scrollvalid = false;
+}
+
+//Wait for the next trigger set by triggerSet(), the input starts again
+//so the graph rolls live until the trigger is met and the new capture stops.
+//========================================================================
+void U8g2GraphingBase::triggerArm() {
+    trigcount = 0;
+    trigprimed = false;
+    trigfired = false;
+    trigfrozen = false;
+    activate = true;
+}
+
+//Return true once a triggered capture is complete and the input stopped.
+//========================================================================
+bool U8g2GraphingBase::isTriggered() {
+    return trigfrozen;
+}
+
 //Set the range and disabling the autorange function.
 //========================================================================
-void U8g2Graphing::rangeSet(bool setrange, float vmin, float vmax) {
+void U8g2GraphingBase::rangeSet(bool setrange, float vmin, float vmax) {
     this->autorange = !setrange;
     this->vmin = vmin;
     this->vmax = vmax;
 }
 
-//Input value converter.
+//Select the fixed-point projection, the scale is computed once per range change
+//and every column is then mapped with an integer multiply and shift.
+//Useful on MCUs without FPU, rows may differ from the float math by one pixel.
 //========================================================================
-void U8g2Graphing::inputValue(float var) {
-    if(isFloat){
-        inValue(var);
-    } else {
-        inValue((int)var);
-    }
-}
-
-void U8g2Graphing::inputValue(int var) {
-    if(isFloat){
-        inValue((float)var);
-    } else {
-        inValue(var);
-    }
+void U8g2GraphingBase::projectionSet(bool fixedpoint) {
+    this->fixedpoint = fixedpoint;
+    projvalid = false;
 }
 
-//Input the data into the buffer and displaying the graph later (floating point),
-//works with both realtime and sampling mode, also works with U8g2 page buffer.
+//Interval gate and timing of a new sample,
+//returns true if the sample has to be stored.
 //========================================================================
-void U8g2Graphing::inValue(float var) {
+bool U8g2GraphingBase::nextSample() {
     if (millis() - curmil >= intvl && activate == true) {
-        if (millis() - curmil < 5) {
-            ppt = micros() - curmcr;
-        } else {
-            ppt = millis() - curmil;
-        }
         curmcr = micros();
         curmil = millis();
+        sampletime = curmcr;
+        return true;
+    }
+    return false;
+}
 
+//Column of a stored sample, advances the ring head when the newest column
+//is full and returns true if the sample starts a new column.
+//A new column stores its time since the previous one and updates the span sums.
+//========================================================================
+bool U8g2GraphingBase::nextColumn() {
+    bool fresh = (decimfill == 0);
+    if (fresh) {
+        colserial++;
         if (ndx >= grwidth - 1) {
             ndx = 0;
         } else {
             ndx++;
         }
-
-        dataset[ndx] = var;
-        graph[ndx][0] = tox + 1;
-
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graph[i][0] -= spd;
-        }
-
-        float minvalget = 1e+6;
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (minvalget > dataset[i]) {
-                minvalget = dataset[i];
-            }
+        uint16_t code = count ? encodeStamp(sampletime - coltime) : 0;
+        coltime = sampletime;
+        if (count == grwidth) {
+            spanus -= decodeStamp(stamp[ndx]);
+        } else {
+            count++;
         }
-
-        float maxvalget = -1e+6;
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (maxvalget < dataset[i]) {
-                maxvalget = dataset[i];
-            }
+        stamp[ndx] = code;
+        spanus += decodeStamp(code);
+        midus += decodeStamp(code);
+        uint16_t half = (grwidth - 1) / 2;
+        if (count > half) {
+            midus -= decodeStamp(stamp[(ndx + grwidth - half) % grwidth]);
         }
+    }
+    decimfill = (decimfill + 1 >= decim) ? 0 : decimfill + 1;
+    return fresh;
+}
 
-        minval = minvalget;
-        maxval = maxvalget;
-
-        mindata = minvalget;
-        maxdata = maxvalget;
+//Timing of a block of samples, the block is only gated by start/stop.
+//The last sample is taken now, the caller steps sampletime by blockstep
+//before storing each sample and advances the ring head.
+//Returns true if the block has to be stored.
+//========================================================================
+bool U8g2GraphingBase::nextBlock(size_t n, uint32_t sampleIntervalUs) {
+    if (activate == false) {
+        return false;
+    }
+    uint32_t now = micros();
+    blockstep = sampleIntervalUs ? sampleIntervalUs : (now - curmcr) / n;
+    sampletime = now - n * blockstep;
+    curmcr = now;
+    curmil = millis();
+    return true;
+}
 
+//Timing of a queued interrupt sample, the timestamp is the sample time.
+//Returns true if the sample has to be stored, queued samples are only gated by start/stop.
+//========================================================================
+bool U8g2GraphingBase::nextStamp(uint32_t timestamp) {
+    if (activate == false) {
+        return false;
     }
+    sampletime = timestamp;
+    return true;
+}
 
+//Apply the manual range and widen a flat range so it can be projected,
+//by at least one part in a million so it still widens large floats.
+//========================================================================
+void U8g2GraphingBase::applyRange() {
     if (!autorange) {
         minval = vmin;
         maxval = vmax;
     }
 
-    if (minval == maxval) {
-        maxval += 0.01;
-        minval -= 0.01;
+    if (isTypeInt) {
+        if ((int)minval == (int)maxval) {
+            maxval += 1;
+            minval -= 1;
+        }
+    } else if (minval == maxval) {
+        float pad = fabs(maxval) * 1e-6f;
+        pad = (pad > 0.01f) ? pad : 0.01f;
+        maxval += pad;
+        minval -= pad;
     }
+}
 
-    for (uint16_t i = 0; i < grwidth; i++) {
-        uint16_t posy = fmap(dataset[i], minval, maxval, (!xaxis) ? toy : toy - 9, fromy);
-        graph[i][1] = constrain(posy, fromy, (!xaxis) ? toy : toy - 9);
+//Check the projection cache against the current range and layout,
+//returns true (and updates the cache) if every column must be reprojected.
+//========================================================================
+bool U8g2GraphingBase::rangeChanged() {
+    uint16_t bottom = (!xaxis) ? toy : toy - 9;
+    if (!projvalid || projmin != minval || projmax != maxval || projbottom != bottom) {
+        projmin = minval;
+        projmax = maxval;
+        projbottom = bottom;
+        projvalid = true;
+        reprojcount++;
+        return true;
     }
+    return false;
 }
 
-//Input the data into the buffer and displaying the graph later (floating point),
-//works with both realtime and sampling mode, also works with U8g2 page buffer.
+//Largest shift that keeps (rows << shift) inside 31 bits.
 //========================================================================
-void U8g2Graphing::inValue(int var) {
-    if (millis() - curmil >= intvl && activate == true) {
-        if (millis() - curmil < 5) {
-            ppt = micros() - curmcr;
-        } else {
-            ppt = millis() - curmil;
-        }
-        curmcr = micros();
-        curmil = millis();
-
-        if (ndx >= grwidth - 1) {
-            ndx = 0;
-        } else {
-            ndx++;
-        }
-
-        datasetInt[ndx] = var;
-        graphInt[ndx][0] = tox + 1;
-
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graphInt[i][0] -= spd;
-        }
-
-        int minvalget = 32000;
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (minvalget > datasetInt[i]) {
-                minvalget = datasetInt[i];
-            }
-        }
-
-        int maxvalget = -32000;
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (maxvalget < datasetInt[i]) {
-                maxvalget = datasetInt[i];
-            }
-        }
-
-        minval = minvalget;
-        maxval = maxvalget;
+uint8_t U8g2GraphingBase::fixedShift() {
+    uint8_t shift = 31;
+    for (uint16_t rows = projbottom - fromy; rows; rows >>= 1) {
+        shift--;
+    }
+    return shift;
+}
 
-        mindata = minvalget;
-        maxdata = maxvalget;
+//Place the columns by their actual time instead of one pixel per column,
+//the oldest column stays at the left edge and gaps show up as wider steps.
+//========================================================================
+void U8g2GraphingBase::timeAxisSet(bool timeaxis) {
+    this->timeaxis = timeaxis;
+    scrollvalid = false;
+}
 
+//Encode the time between two columns in 16 bits, µs up to 32767, then ms up to
+//16383 with the top bit set, then rounded s with the top two bits set.
+//Gaps of 4294 s or longer are counted as 4294 s, so a stamp always decodes to 32 bits.
+//========================================================================
+uint16_t U8g2GraphingBase::encodeStamp(uint32_t us) {
+    if (us < 0x8000) {
+        return us;
     }
-
-    if (!autorange) {
-        minval = vmin;
-        maxval = vmax;
+    if (us < 0x4000 * 1000UL) {
+        return 0x8000 | (us / 1000);
     }
+    us = (us + 500000UL) / 1000000UL;
+    return 0xC000 | ((us < 4294) ? us : 4294);
+}
 
-    if ((int)minval == (int)maxval) {
-        maxval += 1;
-        minval -= 1;
+uint32_t U8g2GraphingBase::decodeStamp(uint16_t stamp) {
+    if (!(stamp & 0x8000)) {
+        return stamp;
+    }
+    if (!(stamp & 0x4000)) {
+        return (uint32_t)(stamp & 0x3FFF) * 1000;
     }
+    return (uint32_t)(stamp & 0x3FFF) * 1000000UL;
+}
 
-    for (uint16_t i = 0; i < grwidth; i++) {
-        uint16_t posy = map(datasetInt[i], minval, maxval, (!xaxis) ? toy : toy - 9, fromy);
-        graphInt[i][1] = constrain(posy, fromy, (!xaxis) ? toy : toy - 9);
+//Time between the oldest and the newest column in µs.
+//========================================================================
+float U8g2GraphingBase::knownSpan() {
+    if (count < 2) {
+        return 0;
     }
+    return (float)(spanus - decodeStamp(stamp[(ndx + 1 + grwidth - count) % grwidth]));
 }
 
-//Clear graph data.
+//Time covered by the full graph width in µs, extrapolated from the
+//filled columns while the graph is still filling up.
 //========================================================================
-void U8g2Graphing::clearData() {
-    if(isFloat){
-        for (uint16_t i = 0; i < grwidth; i++) {
-            dataset[i] = 0;
-        }
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graph[i][0] = fromx;
-            graph[i][1] = toy;
-        }
-    } else {
-        for (uint16_t i = 0; i < grwidth; i++) {
-            datasetInt[i] = 0;
-        }
-        for (uint16_t i = 0; i < grwidth; i++) {
-            graphInt[i][0] = fromx;
-            graphInt[i][1] = toy;
-        }
+float U8g2GraphingBase::farSpan() {
+    float known = knownSpan();
+    if (count < 2 || count == grwidth) {
+        return known;
     }
+    return known * (grwidth - 1) / (count - 1);
+}
+
+//Draw the mean of the first series as a dotted line, sigma adds
+//the mean + and - one standard deviation as sparser dotted lines.
+//========================================================================
+void U8g2GraphingBase::meanSet(bool mean, bool sigma) {
+    meanline = mean;
+    sigmaband = sigma;
+    scrollvalid = false;
+}
+
+//Scrolled rendering for full buffer displays, while the range stays the same
+//the plot area already in the buffer is moved left by the new columns and only
+//those are drawn, so a frame costs the new samples instead of the graph width.
+//The buffer has to keep the previous frame, so do not clearBuffer() the graph
+//area between frames. Every other frame (a range change, the pointer, the mean
+//line, dashed series, the time axis) is drawn in full. Forces a full frame.
+//========================================================================
+void U8g2GraphingBase::scrollSet(bool scroll) {
+    this->scroll = scroll;
+    scrollvalid = false;
 }
 
 //Return the data length of the graph.
 //========================================================================
-uint16_t U8g2Graphing::getDataLen() {
+uint16_t U8g2GraphingBase::getDataLen() {
     return grwidth - 2;
 }
 
 //Return the Min value of the graph, useful for multiple graph with same range.
 //========================================================================
-float U8g2Graphing::getMin() {
+float U8g2GraphingBase::getMin() {
     return minval;
 }
 
 //Return the Max value of the graph, useful for multiple graph with same range.
 //========================================================================
-float U8g2Graphing::getMax() {
+float U8g2GraphingBase::getMax() {
     return maxval;
 }
 
 //Return the Min value from the data set.
 //========================================================================
-float U8g2Graphing::getDataMin() {
+float U8g2GraphingBase::getDataMin() {
     return mindata;
 }
 
 //Return the Max value from the data set.
 //========================================================================
-float U8g2Graphing::getDataMax() {
+float U8g2GraphingBase::getDataMax() {
     return maxdata;
 }
 
-//Standalone function to display the graph.
+//Return the mean of the first series over the graph, O(1) from running sums.
 //========================================================================
-void U8g2Graphing::displayGraph() {
-    if(isFloat){
-        u8g2->setDrawColor(0);
-        u8g2->drawBox(fromx, fromy, tox, toy);
-        u8g2->setDrawColor(1);
-        u8g2->setClipWindow(fromx + 21, fromy, tox, (!xaxis) ? toy + 1 : toy - 8);
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (dotted) {
-                u8g2->drawPixel(graph[i][0], graph[i][1]);
-            } else {
-                if (i == 0) {
-                    u8g2->drawLine(graph[i][0], graph[i][1], graph[i][0] - spd, graph[grwidth - 1][1]);
-                } else {
-                    u8g2->drawLine(graph[i][0], graph[i][1], graph[i][0] - spd, graph[i - 1][1]);
-                }
+float U8g2GraphingBase::getMean() {
+    return statn ? statref + statsum / statn : 0;
+}
+
+//Return the root mean square of the first series over the graph.
+//========================================================================
+float U8g2GraphingBase::getRms() {
+    float mean = getMean();
+    float dev = getStdDev();
+    return sqrt(mean * mean + dev * dev);
+}
+
+//Return the standard deviation of the first series over the graph.
+//========================================================================
+float U8g2GraphingBase::getStdDev() {
+    if (!statn) {
+        return 0;
+    }
+    double mean = statsum / statn;
+    double var = statsq / statn - mean * mean;
+    return (var > 0) ? sqrt(var) : 0;
+}
+
+//Return how many times every column had to be reprojected,
+//a steady range only projects the newly inserted column.
+//========================================================================
+uint32_t U8g2GraphingBase::getReprojectCount() {
+    return reprojcount;
+}
+
+//Send only the tiles of the graph that changed since the last flush(), instead of
+//the whole buffer with sendBuffer(), a slowly changing graph then takes a fraction
+//of the bus time. Full buffer displays only, call it after drawing instead of
+//sendBuffer(). all sends the whole buffer, for frames where the rest of the screen
+//changed, and keeps the tile state in step. The first call sends every tile of
+//the graph. Other rotations and buffer layouts always send the whole buffer.
+//A tile is compared by a 32-bit checksum, a change that collides with the old
+//checksum leaves that tile stale on the panel until it changes again or all is set.
+//The tile state comes from flushBufferSet(), else the heap unless the graph
+//never allocates, which then sends the whole buffer.
+//Returns the number of tiles sent.
+//========================================================================
+uint16_t U8g2GraphingBase::flush(bool all) {
+    u8g2_t *u8g = u8g2->getU8g2();
+    uint8_t bufcols = u8g2->getBufferTileWidth();
+    uint8_t bufrows = u8g2->getBufferTileHeight();
+    if (bufrows * 8 < u8g2->getDisplayHeight()) {
+        return 0;
+    }
+    if (u8g->cb != U8G2_R0 || u8g->ll_hvline != u8g2_ll_hvline_vertical_top_lsb) {
+        u8g2->sendBuffer();
+        return bufcols * bufrows;
+    }
+
+    bool fresh = !tilevalid;
+    if (fresh) {
+        tilex = fromx / 8;
+        tiley = fromy / 8;
+        tilecols = ((tox / 8 < bufcols) ? tox / 8 + 1 : bufcols) - tilex;
+        tilerows = ((toy / 8 < bufrows) ? toy / 8 + 1 : bufrows) - tiley;
+        uint16_t tiles = tilecols * tilerows;
+        if (tiles > tilelen) {
+            if ((tilesum && !tileheap) || fixedstorage) {
+                u8g2->sendBuffer();
+                return bufcols * bufrows;
             }
+            delete [] tilesum;
+            tilesum = new uint32_t[tiles];
+            tilelen = tiles;
+            tileheap = true;
         }
-        u8g2->setMaxClipWindow();
-
-        u8g2->setFont(u8g2_font_tom_thumb_4x6_tn);
-        u8g2->setFontMode(1);
-        if (xaxis) {
-            uint32_t xvalmid;
-            uint32_t xvalfar;
-            if (ppt >= 1000) {
-                xvalfar = ((ppt * (tox - (fromx + 21))) / spd) / 1000;
-                xvalmid = ((ppt * ((tox - (fromx + 21)) / 2)) / spd) / 1000;
-            } else {
-                xvalfar = (ppt * (tox - (fromx + 21))) / spd;
-                xvalmid = (ppt * ((tox - (fromx + 21)) / 2)) / spd;
+        tilevalid = true;
+    }
+
+    uint8_t *buf = u8g2->getBufferPtr();
+    uint16_t sent = 0;
+    for (uint8_t r = 0; r < tilerows; r++) {
+        uint32_t *sum = tilesum + r * tilecols;
+        const uint8_t *tile = buf + ((tiley + r) * bufcols + tilex) * 8;
+        uint8_t run = 0;
+        for (uint8_t c = 0; c <= tilecols; c++) {
+            bool dirty = false;
+            if (c < tilecols) {
+                uint32_t check = tileSum(tile + c * 8);
+                dirty = !all && (fresh || check != sum[c]);
+                sum[c] = check;
             }
-            u8g2->setDrawColor(0);
-            u8g2->drawBox(fromx, toy - 9, tox - fromx + 1, 9);
-            u8g2->setDrawColor(1);
-            u8g2->drawHLine(fromx + 21, toy - 9, tox - fromx - 20);
-            u8g2->drawVLine(tox, toy - 9, 3);
-            u8g2->setCursor(tox - 2, toy);
-            u8g2->print("0");
-            u8g2->drawVLine(fromx + 21, toy - 9, 3);
-            u8g2->setCursor(fromx + ((xvalfar >= 0 && xvalfar < 10) ? 20 :
-            (xvalfar >= 10 && xvalfar < 100) ? 18 :
-            (xvalfar >= 100 && xvalfar < 1000) ? 16 :
-            (xvalfar >= 1000 && xvalfar < 10000) ? 14 :
-            (xvalfar >= 10000 && xvalfar < 100000) ? 12 :
-            (xvalfar >= 100000) ? 10 : 8), toy);
-            u8g2->print(xvalfar);
-            if (tox - (fromx + 21) > 31) {
-                u8g2->drawVLine(tox - ((tox - (fromx + 21)) / 2), toy - 9, 3);
-                u8g2->setCursor((tox - ((tox - (fromx + 21)) / 2)) - ((xvalmid >= 0 && xvalmid < 10) ? 1 :
-                (xvalmid >= 10 && xvalmid < 100) ? 3 :
-                (xvalmid >= 100 && xvalmid < 1000) ? 5 :
-                (xvalmid >= 1000 && xvalmid < 10000) ? 7 :
-                (xvalmid >= 10000 && xvalmid < 100000) ? 9 :
-                (xvalmid >= 100000) ? 11 : 13), toy);
-                u8g2->print(xvalmid);
+            if (dirty) {
+                run++;
+            } else if (run) {
+                u8g2->updateDisplayArea(tilex + c - run, tiley + r, run, 1);
+                sent += run;
+                run = 0;
             }
         }
+    }
+    if (all) {
+        u8g2->sendBuffer();
+        sent = bufcols * bufrows;
+    }
+    return sent;
+}
 
-        u8g2->setDrawColor(0);
-        u8g2->drawBox(fromx, fromy, 21, (!xaxis) ? toy - fromy : toy - fromy - 9);
-        u8g2->setDrawColor(1);
+//Use a caller supplied buffer for the tile state of flush(), flushBytes() gives
+//the size for a graph. nullptr goes back to the heap. A graph that never allocates
+//(a static Capacity or a bufferSet() buffer) needs it for partial transfers.
+//========================================================================
+void U8g2GraphingBase::flushBufferSet(void *buffer, size_t len) {
+    if (tileheap) {
+        delete [] tilesum;
+    }
+    tilesum = (uint32_t *)buffer;
+    tilelen = buffer ? ((len / sizeof(uint32_t) < 0xFFFF) ? len / sizeof(uint32_t) : 0xFFFF) : 0;
+    tileheap = false;
+    tilevalid = false;
+}
 
-        if (!xaxis) {
-            u8g2->drawVLine(fromx + 21, fromy, toy - fromy + 1);
-            u8g2->drawHLine(fromx + 15, fromy, 6);
-            u8g2->drawHLine(fromx + 15, toy, 6);
-            u8g2->drawHLine(fromx + 17, ((toy - fromy) / 2) + fromy, 4);
-            u8g2->setCursor(fromx, fromy + 7);
-            if (maxval >= 1000 || maxval <= -100) {
-                u8g2->print(maxval, 0);
-            } else {
-                u8g2->print(maxval, 1);
+//Checksum of the 8 bytes of a tile, a CRC-16/CCITT (every change of up to 3 pixels)
+//and a Fletcher sum, so a scrolled tile does not pass for the old one.
+//========================================================================
+uint32_t U8g2GraphingBase::tileSum(const uint8_t *tile) {
+    uint16_t crc = 0xFFFF;
+    uint8_t a = 0;
+    uint8_t b = 0;
+    for (uint8_t k = 0; k < 8; k++) {
+        uint8_t x = (crc >> 8) ^ tile[k];
+        x ^= x >> 4;
+        crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x;
+        a += tile[k];
+        b += a;
+    }
+    return ((uint32_t)crc << 16) | ((uint16_t)a << 8) | b;
+}
+
+//Prepare the current page, the first page of a frame also computes the rows
+//covered by the columns, which stay the same for the remaining pages.
+//========================================================================
+void U8g2GraphingBase::beginPage() {
+    if (u8g2->getBufferCurrTileRow() != 0) {
+        return;
+    }
+    if (u8g2->getBufferTileHeight() * 8 >= u8g2->getDisplayHeight()) {
+        framelo = fromy;
+        framehi = toy;
+        return;
+    }
+    framelo = toy;
+    framehi = fromy;
+    for (uint8_t s = 0; s < series; s++) {
+        u8g2_uint_t *hi = graph + s * grwidth;
+        u8g2_uint_t *lo = graphlo + s * grwidth;
+        uint16_t i = ndx;
+        for (uint16_t n = 0; n < count; n++) {
+            if (hi[i] < framelo) {
+                framelo = hi[i];
             }
-            u8g2->setCursor(fromx, toy - 2);
-            if (minval >= 1000 || minval <= -100) {
-                u8g2->print(minval, 0);
-            } else {
-                u8g2->print(minval, 1);
+            if (lo[i] > framehi) {
+                framehi = lo[i];
             }
-        } else {
-            u8g2->drawVLine(fromx + 21, fromy, toy - fromy - 8);
-            u8g2->drawHLine(fromx + 15, fromy, 6);
-            u8g2->drawHLine(fromx + 15, toy - 9, 6);
-            u8g2->drawHLine(fromx + 17, ((toy - fromy - 8) / 2) + fromy, 4);
-            u8g2->setCursor(fromx, fromy + 7);
-            if (maxval >= 1000 || maxval <= -100) {
-                u8g2->print(maxval, 0);
-            } else {
-                u8g2->print(maxval, 1);
+            i = (i == 0) ? grwidth - 1 : i - 1;
+        }
+    }
+}
+
+//Check if a rectangle (inclusive corners) intersects the current page,
+//the page window is in user coordinates so display rotation is respected.
+//========================================================================
+bool U8g2GraphingBase::inPage(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1) {
+    u8g2_t *u8g = u8g2->getU8g2();
+    return x1 >= u8g->user_x0 && x0 < u8g->user_x1 && y1 >= u8g->user_y0 && y0 < u8g->user_y1;
+}
+
+//Draw the graph columns from the projected Y values, every series in one pass
+//over the same clip window, segments outside the current page are skipped.
+//========================================================================
+void U8g2GraphingBase::drawGraph() {
+    if (scrollGraph()) {
+        return;
+    }
+    u8g2->setDrawColor(0);
+    u8g2->drawBox(fromx, fromy, tox, toy);
+    if (scroll) {
+        //The buffer is not cleared between scrolled frames, clear the whole graph.
+        u8g2->drawBox(fromx, fromy, tox - fromx + 1, toy - fromy + 1);
+    }
+    u8g2->setDrawColor(1);
+    drawStats();
+    if (!count || !inPage(fromx + 21, framelo, tox, framehi)) {
+        return;
+    }
+    for (uint8_t s = 0; s < series; s++) {
+        if (spd != 1 || timeaxis || !drawSpans(s)) {
+            drawLines(s);
+        }
+    }
+}
+
+//Move the plot area of a full buffer left by the columns added since the last
+//frame, then clear and draw the new columns and the leftmost one, whose line
+//reaches the wrapped newest slot. Returns false if the frame has to be drawn in full.
+//========================================================================
+bool U8g2GraphingBase::scrollGraph() {
+    u8g2_t *u8g = u8g2->getU8g2();
+    bool able = scroll && spd == 1 && !timeaxis && !pointer && !meanline && !sigmaband && !trigedge &&
+                u8g->cb == U8G2_R0 && u8g->ll_hvline == u8g2_ll_hvline_vertical_top_lsb &&
+                u8g2->getBufferTileHeight() * 8 >= u8g2->getDisplayHeight();
+    for (uint8_t s = 0; s < series; s++) {
+        if (styles[s] == U8G2GRAPH_DASHED) {
+            able = false;
+        }
+    }
+    for (uint8_t m = 0; m < U8G2GRAPH_MAX_MARKERS; m++) {
+        if (markertype[m] != U8G2GRAPH_MARKER_OFF) {
+            able = false;
+        }
+    }
+    uint32_t added = colserial - scrollserial;
+    bool valid = able && scrollvalid && count && reprojcount == scrollreproj && added + 2 < grwidth;
+    scrollvalid = able;
+    scrollserial = colserial;
+    scrollreproj = reprojcount;
+    if (!valid) {
+        return false;
+    }
+
+    uint8_t *buf = u8g2->getBufferPtr();
+    uint16_t bufwidth = u8g2->getBufferTileWidth() * 8;
+    uint16_t clipx0 = fromx + 21;
+    uint16_t clipx1 = (tox < bufwidth) ? tox : bufwidth;
+    uint16_t clipy1 = (!xaxis) ? toy + 1 : toy - 8;
+    if (clipy1 > u8g2->getDisplayHeight()) {
+        clipy1 = u8g2->getDisplayHeight();
+    }
+    uint16_t redraw = (clipx1 > clipx0 + added + 1) ? clipx1 - added - 1 : clipx0;
+    for (uint16_t row = fromy & ~7; row < clipy1; row += 8) {
+        uint8_t mask = 0xFF;
+        if (row < fromy) {
+            mask <<= fromy - row;
+        }
+        if (row + 8 > clipy1) {
+            mask &= 0xFF >> (row + 8 - clipy1);
+        }
+        uint8_t *ptr = buf + (row >> 3) * bufwidth;
+        for (uint16_t x = clipx0; x < redraw; x++) {
+            ptr[x] = (ptr[x] & ~mask) | (ptr[x + added] & mask);
+        }
+        for (uint16_t x = redraw; x < clipx1; x++) {
+            ptr[x] &= ~mask;
+        }
+        ptr[clipx0] &= ~mask;
+    }
+    for (uint8_t s = 0; s < series; s++) {
+        drawSpans(s, redraw, clipx1);
+        drawSpans(s, clipx0, clipx0 + 1);
+    }
+    return true;
+}
+
+//Draw the mean line and the sigma band lines.
+//========================================================================
+void U8g2GraphingBase::drawStats() {
+    if (!statn || !(meanline || sigmaband)) {
+        return;
+    }
+    float mean = getMean();
+    if (meanline) {
+        statLine(mean, 2);
+    }
+    if (sigmaband) {
+        float dev = getStdDev();
+        statLine(mean + dev, 4);
+        statLine(mean - dev, 4);
+    }
+}
+
+//Draw a dotted line at the row of a value, one pixel every step columns.
+//========================================================================
+void U8g2GraphingBase::statLine(float value, uint8_t step) {
+    if (value < minval || value > maxval) {
+        return;
+    }
+    long posy = fmap(value, minval, maxval, projbottom, fromy);
+    u8g2_uint_t y = constrain(posy, (long)fromy, (long)projbottom);
+    if (!inPage(fromx + 21, y, tox, y)) {
+        return;
+    }
+    for (u8g2_uint_t x = tox; x > fromx + 21; x -= step) {
+        u8g2->drawPixel(x, y);
+    }
+}
+
+//Draw one series with the U8g2 line and pixel functions,
+//segments outside the current page are not sent to U8g2 at all.
+//The time axis places every column by the time since the newest one.
+//========================================================================
+void U8g2GraphingBase::drawLines(uint8_t s) {
+    u8g2_t *u8g = u8g2->getU8g2();
+    u8g2_uint_t pagey0 = u8g->user_y0;
+    u8g2_uint_t pagey1 = u8g->user_y1;
+    u8g2_uint_t *col = graph + s * grwidth;
+    U8g2GraphingStyle style = styles[s];
+    float far = timeaxis ? farSpan() : 0;
+    float age = 0;
+    u8g2->setClipWindow(fromx + 21, fromy, tox, (!xaxis) ? toy + 1 : toy - 8);
+    uint16_t i = ndx;
+    uint16_t x = tox + 1 - spd;
+    for (uint16_t n = 0; n < count; n++) {
+        uint16_t prev = (i == 0) ? grwidth - 1 : i - 1;
+        uint16_t step = spd;
+        if (far) {
+            age += decodeStamp(stamp[i]);
+            uint32_t offset = age * (grwidth - 1) / far + 0.5f;
+            uint16_t room = x - fromx;
+            step = (offset - (tox - x) > room) ? room : offset - (tox - x);
+        }
+        if (style == U8G2GRAPH_DASHED && ((tox - x) & 4)) {
+            i = prev;
+            x -= step;
+            continue;
+        }
+        u8g2_uint_t y0 = col[i];
+        u8g2_uint_t y1 = col[i];
+        if (envelope) {
+            envelopeSpan(s, i, prev, y0, y1);
+            if (y1 >= pagey0 && y0 < pagey1) {
+                u8g2->drawVLine(x, y0, y1 - y0 + 1);
             }
-            u8g2->setCursor(fromx, toy - 11);
-            if (minval >= 1000 || minval <= -100) {
-                u8g2->print(minval, 0);
+            i = prev;
+            x -= step;
+            continue;
+        }
+        if (style != U8G2GRAPH_DOTTED) {
+            if (col[prev] < y0) {
+                y0 = col[prev];
             } else {
-                u8g2->print(minval, 1);
+                y1 = col[prev];
             }
         }
-
-        if (pointer) {
-            for (uint16_t i = 0; i < grwidth; i++) {
-                if (graph[i][0] == tox - _pointndx) {
-                    if (graph[i][1] > toy - ((!xaxis) ? 16 : 25)) {
-                        u8g2->drawVLine(graph[i][0], graph[i][1] - 8, 8);
-                        if (graph[i][0] < fromx + 35) {
-                            u8g2->drawBox(fromx + 22, graph[i][1] - 15, 29, 7);
-                            u8g2->setCursor(fromx + 23, graph[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        } else if (graph[i][0] > tox - 16) {
-                            u8g2->drawBox(tox - 28, graph[i][1] - 15, 29, 7);
-                            u8g2->setCursor(tox - 27, graph[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        } else {
-                            u8g2->drawBox(graph[i][0] - 13, graph[i][1] - 15, 29, 7);
-                            u8g2->setCursor(graph[i][0] - 12, graph[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        }
-                    } else {
-                        u8g2->drawVLine(graph[i][0], graph[i][1], 8);
-                        if (graph[i][0] < fromx + 35) {
-                            u8g2->drawBox(fromx + 22, graph[i][1] + 8, 29, 7);
-                            u8g2->setCursor(fromx + 23, graph[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        } else if (graph[i][0] > tox - 16) {
-                            u8g2->drawBox(tox - 28, graph[i][1] + 8, 29, 7);
-                            u8g2->setCursor(tox - 27, graph[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        } else {
-                            u8g2->drawBox(graph[i][0] - 13, graph[i][1] + 8, 29, 7);
-                            u8g2->setCursor(graph[i][0] - 12, graph[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(dataset[i], (dataset[i] >= 0 && dataset[i] < 10) ? 5 :
-                            (dataset[i] >= 10 && dataset[i] < 100 || dataset[i] > -10 && dataset[i] < 0) ? 4 :
-                            (dataset[i] >= 100 && dataset[i] < 1000 || dataset[i] > -100 && dataset[i] <= -10) ? 3 :
-                            (dataset[i] >= 1000 && dataset[i] < 10000 || dataset[i] > -1000 && dataset[i] <= -100) ? 2 :
-                            (dataset[i] >= 10000 || dataset[i] <= -1000) ? 1 : 0);
-                        }
-                    }
-                    u8g2->setDrawColor(1);
-                }
+        if (y1 >= pagey0 && y0 < pagey1) {
+            if (style == U8G2GRAPH_DOTTED) {
+                u8g2->drawPixel(x, col[i]);
+            } else {
+                u8g2->drawLine(x, col[i], x - step, col[prev]);
             }
         }
+        if (x - step < fromx + 21) {
+            break;
+        }
+        i = prev;
+        x -= step;
     }
-    else
-    {
-        u8g2->setDrawColor(0);
-        u8g2->drawBox(fromx, fromy, tox, toy);
-        u8g2->setDrawColor(1);
-        u8g2->setClipWindow(fromx + 21, fromy, tox, (!xaxis) ? toy + 1 : toy - 8);
-        for (uint16_t i = 0; i < grwidth; i++) {
-            if (dotted) {
-                u8g2->drawPixel(graphInt[i][0], graphInt[i][1]);
-            } else {
-                if (i == 0) {
-                    u8g2->drawLine(graphInt[i][0], graphInt[i][1], graphInt[i][0] - spd, graphInt[grwidth - 1][1]);
-                } else {
-                    u8g2->drawLine(graphInt[i][0], graphInt[i][1], graphInt[i][0] - spd, graphInt[i - 1][1]);
-                }
+    u8g2->setMaxClipWindow();
+}
+
+//Write the columns straight into the tile buffer as vertical byte masks,
+//only for unrotated displays with the SSD1306 style vertical byte layout.
+//Every line between neighbouring columns is split into the same two spans
+//u8g2_DrawLine() would produce, so the output is pixel identical.
+//Returns false if the buffer layout is unknown and drawLine() has to be used.
+//========================================================================
+bool U8g2GraphingBase::drawSpans(uint8_t s, uint16_t x0, uint16_t x1) {
+    u8g2_t *u8g = u8g2->getU8g2();
+    if (u8g->cb != U8G2_R0 || u8g->ll_hvline != u8g2_ll_hvline_vertical_top_lsb) {
+        return false;
+    }
+    uint8_t *buf = u8g2->getBufferPtr();
+    uint16_t bufwidth = u8g2->getBufferTileWidth() * 8;
+    uint16_t pagey0 = u8g2->getBufferCurrTileRow() * 8;
+    uint16_t pagey1 = pagey0 + u8g2->getBufferTileHeight() * 8;
+
+    //Same clip window as the drawLine() path, right and bottom edges exclusive,
+    //narrowed to the columns x0 to x1 (exclusive) being drawn.
+    uint16_t clipx0 = (x0 > fromx + 21) ? x0 : fromx + 21;
+    uint16_t clipx1 = (tox < bufwidth) ? tox : bufwidth;
+    if (x1 < clipx1) {
+        clipx1 = x1;
+    }
+    uint16_t clipy0 = (fromy > pagey0) ? fromy : pagey0;
+    uint16_t clipy1 = (!xaxis) ? toy + 1 : toy - 8;
+    if (clipy1 > pagey1) {
+        clipy1 = pagey1;
+    }
+    if (clipy0 >= clipy1) {
+        return true;
+    }
+
+    u8g2_uint_t *column = graph + s * grwidth;
+    bool dotted = (styles[s] == U8G2GRAPH_DOTTED);
+    bool dashed = (styles[s] == U8G2GRAPH_DASHED);
+    uint16_t skip = (tox > clipx1) ? tox - clipx1 : 0;
+    uint16_t i = (ndx + grwidth - skip % grwidth) % grwidth;
+    uint16_t x = tox - skip;
+    for (uint16_t n = skip; n < count && x >= clipx0; n++) {
+        uint16_t prev = (i == 0) ? grwidth - 1 : i - 1;
+        uint16_t a = column[i];
+        uint16_t b = column[prev];
+        for (uint8_t half = 0; half < 2; half++) {
+            if (dashed && ((tox - x) & 4)) {
+                break;
             }
-        }
-        u8g2->setMaxClipWindow();
-
-        u8g2->setFont(u8g2_font_tom_thumb_4x6_tn);
-        u8g2->setFontMode(1);
-        if (xaxis) {
-            uint32_t xvalmid;
-            uint32_t xvalfar;
-            if (ppt >= 1000) {
-                xvalfar = ((ppt * (tox - (fromx + 21))) / spd) / 1000;
-                xvalmid = ((ppt * ((tox - (fromx + 21)) / 2)) / spd) / 1000;
+            uint16_t col, y0, y1;
+            if (envelope) {
+                if (half) {
+                    break;
+                }
+                u8g2_uint_t lo, hi;
+                envelopeSpan(s, i, prev, lo, hi);
+                col = x;
+                y0 = lo;
+                y1 = hi;
+            } else if (dotted || a == b) {
+                if (dotted && half) {
+                    break;
+                }
+                col = x - half;
+                y0 = a;
+                y1 = a;
             } else {
-                xvalfar = (ppt * (tox - (fromx + 21))) / spd;
-                xvalmid = (ppt * ((tox - (fromx + 21)) / 2)) / spd;
+                uint16_t top = (a < b) ? a : b;
+                uint16_t mid = top + ((a < b) ? b - a : a - b) / 2;
+                bool topcol = (half == 0);
+                col = ((a < b) == topcol) ? x : x - 1;
+                y0 = topcol ? top : mid + 1;
+                y1 = topcol ? mid : ((a < b) ? b : a);
+            }
+            if (col < clipx0 || col >= clipx1) {
+                continue;
             }
-            u8g2->setDrawColor(0);
-            u8g2->drawBox(fromx, toy - 9, tox - fromx + 1, 9);
-            u8g2->setDrawColor(1);
-            u8g2->drawHLine(fromx + 21, toy - 9, tox - fromx - 20);
-            u8g2->drawVLine(tox, toy - 9, 3);
-            u8g2->setCursor(tox - 2, toy);
-            u8g2->print("0");
-            u8g2->drawVLine(fromx + 21, toy - 9, 3);
-            u8g2->setCursor(fromx + ((xvalfar >= 0 && xvalfar < 10) ? 20 :
-            (xvalfar >= 10 && xvalfar < 100) ? 18 :
-            (xvalfar >= 100 && xvalfar < 1000) ? 16 :
-            (xvalfar >= 1000 && xvalfar < 10000) ? 14 :
-            (xvalfar >= 10000 && xvalfar < 100000) ? 12 :
-            (xvalfar >= 100000) ? 10 : 8), toy);
-            u8g2->print(xvalfar);
-            if (tox - (fromx + 21) > 31) {
-                u8g2->drawVLine(tox - ((tox - (fromx + 21)) / 2), toy - 9, 3);
-                u8g2->setCursor((tox - ((tox - (fromx + 21)) / 2)) - ((xvalmid >= 0 && xvalmid < 10) ? 1 :
-                (xvalmid >= 10 && xvalmid < 100) ? 3 :
-                (xvalmid >= 100 && xvalmid < 1000) ? 5 :
-                (xvalmid >= 1000 && xvalmid < 10000) ? 7 :
-                (xvalmid >= 10000 && xvalmid < 100000) ? 9 :
-                (xvalmid >= 100000) ? 11 : 13), toy);
-                u8g2->print(xvalmid);
+            if (y0 < clipy0) {
+                y0 = clipy0;
             }
+            if (y1 >= clipy1) {
+                y1 = clipy1 - 1;
+            }
+            if (y0 > y1) {
+                continue;
+            }
+            y0 -= pagey0;
+            y1 -= pagey0;
+            uint8_t *ptr = buf + (y0 >> 3) * bufwidth + col;
+            uint8_t mask = 0xFF << (y0 & 7);
+            for (uint16_t row = y0 & ~7; row <= y1; row += 8) {
+                if (row + 7 > y1) {
+                    mask &= 0xFF >> (7 - (y1 & 7));
+                }
+                *ptr |= mask;
+                ptr += bufwidth;
+                mask = 0xFF;
+            }
+        }
+        i = prev;
+        x--;
+    }
+    return true;
+}
+
+//Rows of an envelope column, from its max to its min. The line style also
+//reaches for the previous column so the envelope has no gaps.
+//========================================================================
+void U8g2GraphingBase::envelopeSpan(uint8_t s, uint16_t i, uint16_t prev, u8g2_uint_t &y0, u8g2_uint_t &y1) {
+    u8g2_uint_t *hi = graph + s * grwidth;
+    u8g2_uint_t *lo = graphlo + s * grwidth;
+    y0 = hi[i];
+    y1 = lo[i];
+    if (styles[s] != U8G2GRAPH_DOTTED && count > 1 && i != (ndx + 1 + grwidth - count) % grwidth) {
+        if (lo[prev] < y0) {
+            y0 = lo[prev];
+        }
+        if (hi[prev] > y1) {
+            y1 = hi[prev];
         }
+    }
+}
 
+//Format the labels whose value changed since the last frame.
+//========================================================================
+void U8g2GraphingBase::updateLabels() {
+    if (!labelvalid || labelmax != maxval) {
+        formatFloat(maxlabel, maxval, (isTypeInt || maxval >= 1000 || maxval <= -100) ? 0 : 1);
+        labelmax = maxval;
+    }
+    if (!labelvalid || labelmin != minval) {
+        formatFloat(minlabel, minval, (isTypeInt || minval >= 1000 || minval <= -100) ? 0 : 1);
+        labelmin = minval;
+    }
+    //Real time of the far and middle ticks, in ms, or in s when a column
+    //spans more than a second. The middle tick is exact once the columns
+    //reach it, the time axis places it at exactly half the span.
+    float far = farSpan();
+    float mid = midus;
+    uint16_t half = (grwidth - 1) / 2;
+    if (timeaxis || count <= half) {
+        mid = far * half / (grwidth - 1);
+    }
+    float unit = (far / (grwidth - 1) >= 1000000.0f) ? 1000000.0f : 1000.0f;
+    uint32_t xvalfar = far / unit;
+    uint32_t xvalmid = mid / unit;
+    if (!labelvalid || labelfar != xvalfar || labelmid != xvalmid) {
+        //Labels are centered on their tick, 2 pixels per digit up to 6 digits.
+        uint8_t len = sprintf(farlabel, "%lu", (unsigned long)xvalfar);
+        farx = fromx + 22 - 2 * ((len < 6) ? len : 6);
+        len = sprintf(midlabel, "%lu", (unsigned long)xvalmid);
+        midx = (tox - ((tox - (fromx + 21)) / 2)) + 1 - 2 * ((len < 6) ? len : 6);
+        labelfar = xvalfar;
+        labelmid = xvalmid;
+    }
+    labelvalid = true;
+}
+
+//Draw the X axis duration labels and the Y axis range labels.
+//========================================================================
+void U8g2GraphingBase::drawAxes() {
+    updateLabels();
+    u8g2->setFont(u8g2_font_tom_thumb_4x6_tn);
+    u8g2->setFontMode(1);
+    if (xaxis && inPage(fromx, toy - 9, tox, toy)) {
         u8g2->setDrawColor(0);
-        u8g2->drawBox(fromx, fromy, 21, (!xaxis) ? toy - fromy : toy - fromy - 9);
+        u8g2->drawBox(fromx, toy - 9, tox - fromx + 1, 9);
         u8g2->setDrawColor(1);
-
-        if (!xaxis) {
-            u8g2->drawVLine(fromx + 21, fromy, toy - fromy + 1);
-            u8g2->drawHLine(fromx + 15, fromy, 6);
-            u8g2->drawHLine(fromx + 15, toy, 6);
-            u8g2->drawHLine(fromx + 17, ((toy - fromy) / 2) + fromy, 4);
-            u8g2->setCursor(fromx, fromy + 7);
-            u8g2->print(maxval, 0);
-            u8g2->setCursor(fromx, toy - 2);
-            u8g2->print(minval, 0);
-        } else {
-            u8g2->drawVLine(fromx + 21, fromy, toy - fromy - 8);
-            u8g2->drawHLine(fromx + 15, fromy, 6);
-            u8g2->drawHLine(fromx + 15, toy - 9, 6);
-            u8g2->drawHLine(fromx + 17, ((toy - fromy - 8) / 2) + fromy, 4);
-            u8g2->setCursor(fromx, fromy + 7);
-            u8g2->print(maxval, 0);
-            u8g2->setCursor(fromx, toy - 11);
-            u8g2->print(minval, 0);
+        u8g2->drawHLine(fromx + 21, toy - 9, tox - fromx - 20);
+        u8g2->drawVLine(tox, toy - 9, 3);
+        u8g2->drawStr(tox - 2, toy, "0");
+        u8g2->drawVLine(fromx + 21, toy - 9, 3);
+        u8g2->drawStr(farx, toy, farlabel);
+        if (tox - (fromx + 21) > 31) {
+            u8g2->drawVLine(tox - ((tox - (fromx + 21)) / 2), toy - 9, 3);
+            u8g2->drawStr(midx, toy, midlabel);
         }
+    }
 
-        if (pointer) {
-            for (uint16_t i = 0; i < grwidth; i++) {
-                if (graphInt[i][0] == tox - _pointndx) {
-                    char bfr[6];
-                    sprintf(bfr, "%i", datasetInt[i]);
-                    byte valength = u8g2->getStrWidth(bfr) + 2;
-                    if (graphInt[i][1] > toy - ((!xaxis) ? 16 : 25)) {
-                        u8g2->drawVLine(graphInt[i][0], graphInt[i][1] - 8, 8);
-                        if (graphInt[i][0] < fromx + (valength / 2) + 21) {
-                            u8g2->drawBox(fromx + 22, graphInt[i][1] - 15, valength, 7);
-                            u8g2->setCursor(fromx + 23, graphInt[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        } else if (graphInt[i][0] > tox - (valength / 2)) {
-                            u8g2->drawBox(tox - valength, graphInt[i][1] - 15, valength, 7);
-                            u8g2->setCursor(tox - valength + 1, graphInt[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        } else {
-                            u8g2->drawBox(graphInt[i][0] - (valength / 2), graphInt[i][1] - 15, valength, 7);
-                            u8g2->setCursor(graphInt[i][0] - ((valength / 2) - 1), graphInt[i][1] - 9);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        }
-                    } else {
-                        u8g2->drawVLine(graphInt[i][0], graphInt[i][1], 8);
-                        if (graphInt[i][0] < fromx + (valength / 2) + 21) {
-                            u8g2->drawBox(fromx + 22, graphInt[i][1] + 8, valength, 7);
-                            u8g2->setCursor(fromx + 23, graphInt[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        } else if (graphInt[i][0] > tox - (valength / 2)) {
-                            u8g2->drawBox(tox - valength, graphInt[i][1] + 8, valength, 7);
-                            u8g2->setCursor(tox - valength + 1, graphInt[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        } else {
-                            u8g2->drawBox(graphInt[i][0] - (valength / 2), graphInt[i][1] + 8, valength, 7);
-                            u8g2->setCursor(graphInt[i][0] - ((valength / 2) - 1), graphInt[i][1] + 14);
-                            u8g2->setDrawColor(0);
-                            u8g2->print(bfr);
-                        }
-                    }
-                    u8g2->setDrawColor(1);
-                }
+    if (!inPage(fromx, fromy, fromx + 21, toy)) {
+        return;
+    }
+    u8g2->setDrawColor(0);
+    u8g2->drawBox(fromx, fromy, 21, (!xaxis) ? toy - fromy : toy - fromy - 9);
+    u8g2->setDrawColor(1);
+
+    if (!xaxis) {
+        u8g2->drawVLine(fromx + 21, fromy, toy - fromy + 1);
+        u8g2->drawHLine(fromx + 15, fromy, 6);
+        u8g2->drawHLine(fromx + 15, toy, 6);
+        u8g2->drawHLine(fromx + 17, ((toy - fromy) / 2) + fromy, 4);
+    } else {
+        u8g2->drawVLine(fromx + 21, fromy, toy - fromy - 8);
+        u8g2->drawHLine(fromx + 15, fromy, 6);
+        u8g2->drawHLine(fromx + 15, toy - 9, 6);
+        u8g2->drawHLine(fromx + 17, ((toy - fromy - 8) / 2) + fromy, 4);
+    }
+    if (inPage(fromx, fromy, fromx + 20, fromy + 7)) {
+        u8g2->drawStr(fromx, fromy + 7, maxlabel);
+    }
+    u8g2_uint_t miny = (!xaxis) ? toy - 2 : toy - 11;
+    if (inPage(fromx, miny - 6, fromx + 20, miny)) {
+        u8g2->drawStr(fromx, miny, minlabel);
+    }
+}
+
+//Resolve the pointer index to its ring slot and screen X,
+//returns false if the pointer is off or points to an empty column.
+//On the time axis the pointer snaps to the first column at or left of its X.
+//========================================================================
+bool U8g2GraphingBase::pointerSlot(uint16_t pointndx, uint16_t &slot, u8g2_uint_t &px) {
+    float far = timeaxis ? farSpan() : 0;
+    if (far) {
+        float age = 0;
+        uint16_t i = ndx;
+        for (uint16_t n = 0; n < count; n++) {
+            uint32_t offset = age * (grwidth - 1) / far + 0.5f;
+            if (offset >= pointndx) {
+                slot = i;
+                px = tox - offset;
+                return true;
             }
+            age += decodeStamp(stamp[i]);
+            i = (i == 0) ? grwidth - 1 : i - 1;
         }
+        return false;
+    }
+    if ((pointndx + 1) % spd != 0 || (pointndx + 1) / spd > count) {
+        return false;
+    }
+    uint16_t age = (pointndx + 1) / spd - 1;
+    slot = (ndx + grwidth - age) % grwidth;
+    px = tox - pointndx;
+    return true;
+}
+
+//Screen X of a ring slot, on the time axis from the time since the newest column.
+//========================================================================
+u8g2_uint_t U8g2GraphingBase::slotX(uint16_t slot) {
+    uint16_t age = (ndx + grwidth - slot) % grwidth;
+    float far = timeaxis ? farSpan() : 0;
+    if (!far) {
+        return tox - age * spd;
+    }
+    float us = 0;
+    uint16_t i = ndx;
+    for (uint16_t n = 0; n < age; n++) {
+        us += decodeStamp(stamp[i]);
+        i = (i == 0) ? grwidth - 1 : i - 1;
+    }
+    return tox - (u8g2_uint_t)(us * (grwidth - 1) / far + 0.5f);
+}
+
+//Draw the pointer line and its readout box, placed above or below the point,
+//returns the label baseline, the caller draws the label with the inverted color.
+//========================================================================
+u8g2_uint_t U8g2GraphingBase::pointerBox(u8g2_uint_t px, u8g2_uint_t py, u8g2_uint_t boxx, uint8_t width) {
+    u8g2_uint_t basey;
+    if (py > toy - ((!xaxis) ? 16 : 25)) {
+        u8g2->drawVLine(px, py - 8, 8);
+        u8g2->drawBox(boxx, py - 15, width, 7);
+        basey = py - 9;
+    } else {
+        u8g2->drawVLine(px, py, 8);
+        u8g2->drawBox(boxx, py + 8, width, 7);
+        basey = py + 14;
+    }
+    u8g2->setDrawColor(0);
+    return basey;
+}
+
+//Floating point pointer readout, fixed width box with a precision
+//that keeps the value inside it.
+//========================================================================
+void U8g2GraphingBase::drawPointerFloat(u8g2_uint_t px, u8g2_uint_t py, float value, U8g2GraphingReadout &readout) {
+    formatReadout(readout, value);
+    u8g2_uint_t boxx;
+    if (px < fromx + 35) {
+        boxx = fromx + 22;
+    } else if (px > tox - 16) {
+        boxx = tox - 28;
+    } else {
+        boxx = px - 13;
+    }
+    u8g2_uint_t basey = pointerBox(px, py, boxx, 29);
+    u8g2->drawStr(boxx + 1, basey, readout.label);
+    u8g2->setDrawColor(1);
+}
+
+//Integer pointer readout, the box is sized to the printed value.
+//========================================================================
+void U8g2GraphingBase::drawPointerInt(u8g2_uint_t px, u8g2_uint_t py, long value, U8g2GraphingReadout &readout) {
+    formatReadout(readout, value);
+    uint8_t width = readout.width;
+    u8g2_uint_t boxx;
+    if (px < fromx + (width / 2) + 21) {
+        boxx = fromx + 22;
+    } else if (px > tox - (width / 2)) {
+        boxx = tox - width;
+    } else {
+        boxx = px - (width / 2);
+    }
+    u8g2_uint_t basey = pointerBox(px, py, boxx, width);
+    u8g2->drawStr(boxx + 1, basey, readout.label);
+    u8g2->setDrawColor(1);
+}
+
+//Level marker, a dotted line at the row of the value with the value
+//in a box at its left end. Nothing is drawn outside the range.
+//========================================================================
+void U8g2GraphingBase::drawLevel(float value, U8g2GraphingReadout &readout) {
+    if (value < minval || value > maxval) {
+        return;
+    }
+    long posy = fmap(value, minval, maxval, projbottom, fromy);
+    u8g2_uint_t y = constrain(posy, (long)fromy, (long)projbottom);
+    if (!inPage(fromx + 21, (y > 3) ? y - 3 : 0, tox, y + 3)) {
+        return;
+    }
+    for (u8g2_uint_t x = tox; x > fromx + 21; x -= 3) {
+        u8g2->drawPixel(x, y);
+    }
+    if (isTypeInt) {
+        formatReadout(readout, (long)value);
+    } else {
+        formatReadout(readout, value);
+    }
+    u8g2_uint_t boxy = (y > fromy + 3) ? y - 3 : fromy;
+    if (boxy + 7 > projbottom + 1) {
+        boxy = projbottom - 6;
+    }
+    u8g2->drawBox(fromx + 22, boxy, readout.width, 7);
+    u8g2->setDrawColor(0);
+    u8g2->drawStr(fromx + 23, boxy + 6, readout.label);
+    u8g2->setDrawColor(1);
+}
+
+//Trigger mark, a dotted line through the trigger column with a small arrow on top.
+//========================================================================
+void U8g2GraphingBase::drawTrigger() {
+    u8g2_uint_t x = slotX(trigslot);
+    if (!inPage(x - 2, fromy, x + 2, projbottom)) {
+        return;
+    }
+    u8g2->drawHLine(x - 2, fromy, 5);
+    u8g2->drawHLine(x - 1, fromy + 1, 3);
+    for (u8g2_uint_t y = fromy + 2; y <= projbottom; y += 2) {
+        u8g2->drawPixel(x, y);
+    }
+}
+
+//Format a float readout with a precision that keeps it inside the fixed width box.
+//========================================================================
+void U8g2GraphingBase::formatReadout(U8g2GraphingReadout &readout, float value) {
+    if (readout.valid && readout.value == value) {
+        return;
+    }
+    formatFloat(readout.label, value, (value >= 0 && value < 10) ? 5 :
+    ((value >= 10 && value < 100) || (value > -10 && value < 0)) ? 4 :
+    ((value >= 100 && value < 1000) || (value > -100 && value <= -10)) ? 3 :
+    ((value >= 1000 && value < 10000) || (value > -1000 && value <= -100)) ? 2 :
+    (value >= 10000 || value <= -1000) ? 1 : 0);
+    readout.value = value;
+    readout.width = 29;
+    readout.valid = true;
+}
+
+//Format an integer readout, the box is sized to the printed value.
+//========================================================================
+void U8g2GraphingBase::formatReadout(U8g2GraphingReadout &readout, long value) {
+    if (readout.valid && readout.valueint == value) {
+        return;
+    }
+    sprintf(readout.label, "%ld", value);
+    readout.width = u8g2->getStrWidth(readout.label) + 2;
+    readout.valueint = value;
+    readout.valid = true;
+}
+
+//Float to text, same output as Print::print(value, digits)
+//but into a buffer so it can be cached.
+//========================================================================
+void U8g2GraphingBase::formatFloat(char *bfr, double number, uint8_t digits) {
+    if (isnan(number)) {
+        strcpy(bfr, "nan");
+        return;
+    }
+    if (isinf(number)) {
+        strcpy(bfr, "inf");
+        return;
+    }
+    if (number > 4294967040.0 || number < -4294967040.0) {
+        strcpy(bfr, "ovf");
+        return;
+    }
+    if (number < 0.0) {
+        *bfr++ = '-';
+        number = -number;
+    }
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; i++) {
+        rounding /= 10.0;
+    }
+    number += rounding;
+    unsigned long intpart = (unsigned long)number;
+    double remainder = number - (double)intpart;
+    bfr += sprintf(bfr, "%lu", intpart);
+    if (digits > 0) {
+        *bfr++ = '.';
+    }
+    while (digits-- > 0) {
+        remainder *= 10.0;
+        uint8_t digit = (uint8_t)remainder;
+        *bfr++ = '0' + digit;
+        remainder -= digit;
     }
+    *bfr = 0;
 }
 
 //Private floating point map function.
 //========================================================================
-float U8g2Graphing::fmap(float x, float in_min, float in_max, float out_min, float out_max) {
+float U8g2GraphingBase::fmap(float x, float in_min, float in_max, float out_min, float out_max) {
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
@@ -11,48 +11,2179 @@
 #include <Arduino.h>
 #include <U8g2lib.h>
 
-class U8g2Graphing
+//Compile-time description of a sample type: value limits used to clamp
+//incoming data and the integer width used by the projection math.
+template <typename T> struct U8g2GraphingTraits;
+
+template <> struct U8g2GraphingTraits<float> {
+    static const bool isInteger = false;
+    typedef long wide_t;
+    static float lowest() { return -3.4e+38; }
+    static float highest() { return 3.4e+38; }
+};
+
+template <> struct U8g2GraphingTraits<int8_t> {
+    static const bool isInteger = true;
+    typedef long wide_t;
+    static int8_t lowest() { return -128; }
+    static int8_t highest() { return 127; }
+};
+
+template <> struct U8g2GraphingTraits<uint8_t> {
+    static const bool isInteger = true;
+    typedef long wide_t;
+    static uint8_t lowest() { return 0; }
+    static uint8_t highest() { return 255; }
+};
+
+template <> struct U8g2GraphingTraits<int16_t> {
+    static const bool isInteger = true;
+    typedef long wide_t;
+    static int16_t lowest() { return -32768; }
+    static int16_t highest() { return 32767; }
+};
+
+template <> struct U8g2GraphingTraits<uint16_t> {
+    static const bool isInteger = true;
+    typedef long wide_t;
+    static uint16_t lowest() { return 0; }
+    static uint16_t highest() { return 65535; }
+};
+
+template <> struct U8g2GraphingTraits<int32_t> {
+    static const bool isInteger = true;
+    typedef int64_t wide_t;
+    static int32_t lowest() { return -2147483647L - 1; }
+    static int32_t highest() { return 2147483647L; }
+};
+
+template <> struct U8g2GraphingTraits<uint32_t> {
+    static const bool isInteger = true;
+    typedef int64_t wide_t;
+    static uint32_t lowest() { return 0; }
+    static uint32_t highest() { return 4294967295UL; }
+};
+
+//Return type of the inputValue() taking the sample type itself, only defined
+//when the argument is exactly SampleT and neither float nor int, which the
+//other overloads already take, so 32-bit samples are stored without rounding.
+template <typename T, typename SampleT> struct U8g2GraphingSampleInput {};
+template <typename T> struct U8g2GraphingSampleInput<T, T> {
+    typedef void type;
+};
+template <> struct U8g2GraphingSampleInput<float, float> {};
+template <> struct U8g2GraphingSampleInput<int, int> {};
+
+//Most series one graph can hold.
+#define U8G2GRAPH_MAX_SERIES 4
+
+//Sample queue indices, single bytes on AVR where wider loads are not atomic,
+//16 bits on 32-bit cores so a sampler task can queue a whole display transfer.
+#if defined(__AVR__)
+typedef uint8_t U8g2GraphingQueueIndex;
+#define U8G2GRAPH_QUEUE_MAX 256
+#else
+typedef uint16_t U8g2GraphingQueueIndex;
+#define U8G2GRAPH_QUEUE_MAX 4096
+#endif
+
+//Read a queue index before touching the entries it hands over, and publish it
+//after them. Acquire and release also order the entries between the cores of
+//an ESP32 or RP2040, AVR has a single core and only needs a compiler barrier.
+inline U8g2GraphingQueueIndex queueAcquire(volatile U8g2GraphingQueueIndex &index) {
+#if defined(__AVR__)
+    U8g2GraphingQueueIndex value = index;
+    __asm__ __volatile__("" ::: "memory");
+    return value;
+#else
+    return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline void queueRelease(volatile U8g2GraphingQueueIndex &index, U8g2GraphingQueueIndex value) {
+#if defined(__AVR__)
+    __asm__ __volatile__("" ::: "memory");
+    index = value;
+#else
+    __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#endif
+}
+
+//Most markers one graph can hold.
+#define U8G2GRAPH_MAX_MARKERS 4
+
+//Kind of a marker, a cursor at a column, a level line at a value
+//(e.g. an alarm threshold) or the column holding the current min or max.
+enum U8g2GraphingMarker : uint8_t {
+    U8G2GRAPH_MARKER_OFF,
+    U8G2GRAPH_MARKER_CURSOR,
+    U8G2GRAPH_MARKER_LEVEL,
+    U8G2GRAPH_MARKER_MIN,
+    U8G2GRAPH_MARKER_MAX
+};
+
+//Text and width of a readout box, only formatted again when its value changes.
+struct U8g2GraphingReadout {
+    char label[14];
+    float value;
+    long valueint;
+    uint8_t width;
+    bool valid;
+};
+
+//Samples per block of a packed history (a power of two).
+#define U8G2GRAPH_PACK_BLOCK 32
+
+//Hot path instrumentation, define as 1 before including the library (or in the
+//build flags) to fill getStats(). Left at 0 the timing code is not compiled at all.
+#ifndef U8G2GRAPH_STATS
+#define U8G2GRAPH_STATS 0
+#endif
+
+//Line style of a series.
+enum U8g2GraphingStyle : uint8_t {
+    U8G2GRAPH_SOLID,
+    U8G2GRAPH_DOTTED,
+    U8G2GRAPH_DASHED
+};
+
+//Edge of the first series that triggers a capture.
+enum U8g2GraphingTrigger : uint8_t {
+    U8G2GRAPH_TRIGGER_OFF,
+    U8G2GRAPH_TRIGGER_RISING,
+    U8G2GRAPH_TRIGGER_FALLING
+};
+
+//Format of exportData(), comma separated text or little endian binary records.
+enum U8g2GraphingExport : uint8_t {
+    U8G2GRAPH_EXPORT_CSV,
+    U8G2GRAPH_EXPORT_BINARY
+};
+
+//Progress of exportData(), DONE (0) once the export is complete or none runs,
+//WAITING if the stream had no room for a single byte on this call.
+enum U8g2GraphingExportState : uint8_t {
+    U8G2GRAPH_EXPORT_DONE,
+    U8G2GRAPH_EXPORT_SENDING,
+    U8G2GRAPH_EXPORT_WAITING
+};
+
+//Time spent in one stage, totals and extremes in µs.
+struct U8g2GraphingStage {
+    uint32_t calls;
+    uint32_t total;
+    uint32_t min;
+    uint32_t max;
+};
+
+//Instrumentation counters of a graph, see U8G2GRAPH_STATS.
+//input covers every input and queue drain, render the displayGraph() calls
+//of one frame and frame the time from one frame to the next, so the time
+//not spent rendering is the display transfer and the rest of the loop.
+struct U8g2GraphingStats {
+    U8g2GraphingStage input;
+    U8g2GraphingStage render;
+    U8g2GraphingStage frame;
+    uint32_t gated;
+    uint32_t stopped;
+    uint32_t dropped;
+    uint32_t reprojections;
+};
+
+//Storage layout of a graph: samples first (padded to 16 bits), the time stamp
+//of every column, then the min queue, the max queue and the projected Y of every column.
+//The decimation envelope adds the column minimum and its projected Y,
+//every series has its own samples and Y, more than one series adds
+//the combined min and max of every column for the shared autorange.
+template <typename SampleT> struct U8g2GraphingLayout {
+    static constexpr size_t sampleBytes(uint16_t width) {
+        return (width * sizeof(SampleT) + 1) / 2 * 2;
+    }
+    static constexpr size_t storageBytes(uint16_t width, bool envelope = false, uint8_t series = 1) {
+        return (series * (envelope ? 2 : 1) + (series > 1 ? 2 : 0)) * sampleBytes(width) +
+               width * sizeof(uint16_t) + (2 + series * (envelope ? 2 : 1)) * width * sizeof(u8g2_uint_t);
+    }
+};
+
+//Type independent part of the graph: settings, timing, range handling
+//and everything drawn from the projected column Y values.
+class U8g2GraphingBase
 {
 public:
-    U8g2Graphing(U8G2 *u8g);
-    ~U8g2Graphing();
-    void begin(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy);
-    void beginInt(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy);
     void start();
     void stop();
     void startSampling(bool sample);
     void intervalSet(uint32_t intvl);
     void displaySet(bool xaxis, bool dotted = false);
+    void seriesStyle(uint8_t index, U8g2GraphingStyle style);
     void pointerSet(bool pointer, uint16_t pointndx = 0);
     void pointerSetI(bool pointer, uint16_t pointndx = 0);
+    void markerSet(uint8_t index, U8g2GraphingMarker type, float position = 0);
+    void triggerArm();
+    bool isTriggered();
     void rangeSet(bool setrange, float vmin = 0, float vmax = 0);
-    void inputValue(float var);
-    void inputValue(int var);
-    void clearData();
+    void projectionSet(bool fixedpoint);
+    void timeAxisSet(bool timeaxis);
+    void meanSet(bool mean, bool sigma = false);
+    void scrollSet(bool scroll);
     uint16_t getDataLen();
     float getMin();
     float getMax();
     float getDataMin();
     float getDataMax();
-    void displayGraph();
+    float getMean();
+    float getRms();
+    float getStdDev();
+    uint32_t getReprojectCount();
+    uint16_t flush(bool all = false);
+    void flushBufferSet(void *buffer, size_t len);
 
-private:
-    void inValue(float var);
-    void inValue(int var);
-    void resetArray();
+    //Bytes of the flush() tile state of a graph spanning width x height pixels,
+    //usable as an array size for flushBufferSet().
+    static constexpr size_t flushBytes(uint16_t width, uint16_t height) {
+        return (size_t)((width + 14) / 8) * ((height + 14) / 8) * sizeof(uint32_t);
+    }
+
+protected:
+    U8g2GraphingBase(U8G2 *u8g);
+    ~U8g2GraphingBase();
+    void setGeometry(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy);
+    void resetState(bool isTypeInt);
+    void resetWindow();
+    bool nextSample();
+    bool nextColumn();
+    bool nextBlock(size_t n, uint32_t sampleIntervalUs);
+    bool nextStamp(uint32_t timestamp);
+    void applyRange();
+    bool rangeChanged();
+    uint8_t fixedShift();
+    static uint16_t encodeStamp(uint32_t us);
+    static uint32_t decodeStamp(uint16_t stamp);
+    float knownSpan();
+    float farSpan();
+    void beginPage();
+    bool inPage(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1);
+    void drawGraph();
+    bool scrollGraph();
+    void drawLines(uint8_t s);
+    bool drawSpans(uint8_t s, uint16_t x0 = 0, uint16_t x1 = 0xFFFF);
+    void envelopeSpan(uint8_t s, uint16_t i, uint16_t prev, u8g2_uint_t &y0, u8g2_uint_t &y1);
+    void drawStats();
+    void statLine(float value, uint8_t step);
+    void drawAxes();
+    void updateLabels();
+    void formatFloat(char *bfr, double number, uint8_t digits);
+    bool pointerSlot(uint16_t pointndx, uint16_t &slot, u8g2_uint_t &px);
+    u8g2_uint_t slotX(uint16_t slot);
+    static uint32_t tileSum(const uint8_t *tile);
+    u8g2_uint_t pointerBox(u8g2_uint_t px, u8g2_uint_t py, u8g2_uint_t boxx, uint8_t width);
+    void drawPointerFloat(u8g2_uint_t px, u8g2_uint_t py, float value, U8g2GraphingReadout &readout);
+    void drawPointerInt(u8g2_uint_t px, u8g2_uint_t py, long value, U8g2GraphingReadout &readout);
+    void drawLevel(float value, U8g2GraphingReadout &readout);
+    void drawTrigger();
+    void formatReadout(U8g2GraphingReadout &readout, float value);
+    void formatReadout(U8g2GraphingReadout &readout, long value);
     float fmap(float x, float in_min, float in_max, float out_min, float out_max);
 
-    uint16_t grwidth, fromx, fromy, tox, toy, ndx, _pointndx, spd;
+    uint16_t grwidth, fromx, fromy, tox, toy, ndx, count, _pointndx, spd;
+
+    //Right edge given to begin(), tox is moved left of it when the storage
+    //holds fewer columns than endx - fromx - 20.
+    uint16_t endx;
+    uint16_t minhead, minlen, maxhead, maxlen;
     float minval, maxval, mindata, maxdata, vmin, vmax;
-    uint32_t curmil, curmcr, ppt, intvl;
-    bool graphstart, activate, xaxis, autorange, pointer, dotted, isFloat, isTypeInt;
+    uint32_t curmil, curmcr, intvl;
+    bool activate, xaxis, autorange, pointer, isTypeInt, fixedpoint;
+
+    //Time of every column, stamp[i] is the encoded time since the previous column.
+    //sampletime is the µs time of the sample being stored, blockstep the sample
+    //period of a block, spanus and midus the running sums of the stamps of every
+    //column and of the columns up to the middle X axis tick, 64 bits wide as a
+    //graph of long gaps spans more than the 71 minutes 32 bits of µs hold.
+    uint32_t sampletime, coltime, blockstep;
+    uint64_t spanus, midus;
+    bool timeaxis;
+
+    //Series sharing the time base and the range, series s of column i
+    //is at s * grwidth + i in the sample and Y arrays.
+    uint8_t series;
+    U8g2GraphingStyle styles[U8G2GRAPH_MAX_SERIES];
+
+    //Decimation, every column keeps the min and max of decim samples,
+    //decimfill is the number of samples already merged into the newest column.
+    uint16_t decim, decimfill;
+    bool envelope;
+
+    //Running statistics of the first series over the filled columns, a decimated
+    //column counts as the middle of its envelope. The sums are kept relative to
+    //statref and rebuilt from the columns every few widths to drop the rounding drift.
+    double statref, statsum, statsq;
+    uint16_t statn, statfix;
+    bool meanline, sigmaband;
 
-    uint16_t **graph = nullptr;
-    float *dataset = nullptr;
-    uint8_t **graphInt = nullptr;
-    int *datasetInt = nullptr;
+    //Range and bottom row the cached column Y values were projected with,
+    //every column is only reprojected when one of them changes.
+    float projmin, projmax;
+    uint16_t projbottom;
+    bool projvalid;
+    uint32_t reprojcount = 0;
+
+    //Fixed-point projection, row = bottom - ((offset * projscale + projround) >> projshift),
+    //the scale is computed once per range change so columns need no division.
+    bool projfixed;
+    uint8_t projshift, projpre;
+    uint32_t projscale, projround;
+    float projscalef;
+
+    //Scrolled rendering, colserial counts every new column, scrollserial and scrollreproj
+    //are the column count and reprojection count of the last frame, scrollvalid
+    //is set when the plot area of the buffer still holds that frame.
+    uint32_t colserial = 0;
+    uint32_t scrollserial, scrollreproj;
+    bool scroll, scrollvalid;
+
+    //Export of the columns exportfirst to exportlast (column serials), exportnext is
+    //the next one to send, exportstage the header lines sent so far and exportpos
+    //the bytes already sent of a row split over several calls.
+    U8g2GraphingExport exportformat;
+    uint32_t exportfirst, exportnext, exportlast;
+    uint8_t exportstage, exportpos;
+    bool exporting;
+
+    //Rows covered by the drawn columns, computed on the first page of a frame
+    //so the other pages of a page buffer display can skip the columns entirely.
+    u8g2_uint_t framelo, framehi;
+
+    //Formatted axis and pointer labels, each one is only formatted again
+    //when the value it shows changes, steady frames just draw the strings.
+    char maxlabel[12], minlabel[12], farlabel[11], midlabel[11];
+    float labelmax, labelmin;
+    uint32_t labelfar, labelmid;
+    u8g2_uint_t farx, midx;
+    bool labelvalid;
+    U8g2GraphingReadout ptrreadout;
+
+    //Triggered capture, trigcount counts the columns since arming until the trigger,
+    //then the columns still to add after the trigger column trigslot. A trigger needs
+    //trigpre columns before it and the signal past the hysteresis (trigprimed) first.
+    U8g2GraphingTrigger trigedge;
+    uint16_t trigpre, trigcount, trigslot;
+    bool trigprimed, trigfired, trigfrozen;
+
+    //Markers, position is the column offset of a cursor or the value of a level line.
+    U8g2GraphingMarker markertype[U8G2GRAPH_MAX_MARKERS];
+    float markerpos[U8G2GRAPH_MAX_MARKERS];
+    U8g2GraphingReadout markerreadout[U8G2GRAPH_MAX_MARKERS];
+
+    //Views into the storage block of the derived graph, ndx is the ring head
+    //(newest sample) and count is the number of filled columns.
+    //graphlo is the same view as graph without the decimation envelope.
+    u8g2_uint_t *minq = nullptr;
+    u8g2_uint_t *maxq = nullptr;
+    u8g2_uint_t *graph = nullptr;
+    u8g2_uint_t *graphlo = nullptr;
+    uint16_t *stamp = nullptr;
+
+    //Checksum of every 8x8 tile of the display buffer covered by the graph
+    //as last sent by flush(), tilecols x tilerows tiles from tilex, tiley.
+    //tilelen is the room of tilesum in tiles, tileheap is set if flush() allocated
+    //it, tilevalid is cleared by a new geometry. fixedstorage is set by graphs
+    //that never allocate (a static Capacity or a bufferSet() buffer).
+    uint32_t *tilesum = nullptr;
+    uint16_t tilelen = 0;
+    uint8_t tilex, tiley, tilecols, tilerows;
+    bool tileheap = false;
+    bool tilevalid = false;
+    bool fixedstorage = false;
+
+    //Interrupt sample queue, isrhead is only written by pushFromISR() and isrtail
+    //only by update(). The indices are read and written atomically on every core.
+    volatile U8g2GraphingQueueIndex isrhead = 0;
+    volatile U8g2GraphingQueueIndex isrtail = 0;
+    U8g2GraphingQueueIndex isrmask = 0;
 
     U8G2 *u8g2 = nullptr;
 };
 
+//Graph engine specialized for one sample type at compile time.
+//Capacity 0 keeps the storage on the heap (or in a buffer given to bufferSet()),
+//any other value reserves room for that many columns inside the object itself.
+//A graph spans tox - fromx - 20 columns, or fewer if its storage is smaller,
+//see layout().
+template <typename SampleT, uint16_t Capacity = 0>
+class U8g2GraphingT : public U8g2GraphingBase
+{
+public:
+    U8g2GraphingT(U8G2 *u8g);
+    ~U8g2GraphingT();
+
+    //Exact storage bytes of a graph with the given number of columns,
+    //usable as an array size for bufferSet().
+    static constexpr size_t bytesNeeded(uint16_t columns, bool envelope = false, uint8_t series = 1) {
+        return U8g2GraphingLayout<SampleT>::storageBytes(columns, envelope, series);
+    }
+
+    //Bytes of a history of the given number of samples (a power of two),
+    //the samples plus their min/max pyramid.
+    static constexpr size_t historyBytes(uint32_t samples) {
+        return (3 * samples - 2) * sizeof(SampleT);
+    }
+
+    //Smallest buffer of a packed history, the open block plus one block of the widest deltas.
+    static constexpr size_t packedBytes() {
+        return U8G2GRAPH_PACK_BLOCK * sizeof(SampleT) + 1 + 3 * sizeof(SampleT) +
+               ((8 * sizeof(SampleT) + 1) * (U8G2GRAPH_PACK_BLOCK - 1) + 7) / 8;
+    }
+
+    void bufferSet(void *buffer, size_t len);
+    void begin(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy);
+    void beginInt(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy);
+    void inputValue(float var);
+    void inputValue(int var);
+    template <typename T> typename U8g2GraphingSampleInput<T, SampleT>::type inputValue(T var);
+    void inputValues(const SampleT *data, size_t n, uint32_t sampleIntervalUs = 0);
+    void inputSeries(const SampleT *row);
+    void decimationSet(uint16_t samplesPerColumn);
+    void seriesSet(uint8_t count);
+    void queueSet(uint16_t size);
+    bool pushFromISR(SampleT value, uint32_t timestamp);
+    bool pushFromISR(const SampleT *row, uint32_t timestamp);
+    void update();
+    void triggerSet(U8g2GraphingTrigger edge, float level, float hysteresis = 0, float pretrigger = 0.5);
+    void historySet(uint32_t samples);
+    void historySet(void *buffer, size_t len);
+    void historyPackedSet(size_t bytes);
+    void historyPackedSet(void *buffer, size_t len);
+    void setView(uint32_t offset, uint16_t samplesPerColumn);
+    uint32_t getHistoryLen();
+    void clearData();
+    void displayGraph();
+    float getPeakToPeak();
+    U8g2GraphingStats getStats();
+    void clearStats();
+    void printStats(Stream &out);
+    void exportStart(U8g2GraphingExport format);
+    U8g2GraphingExportState exportData(Stream &out, size_t maxBytes = 0);
+
+private:
+    typedef U8g2GraphingTraits<SampleT> Traits;
+    typedef U8g2GraphingLayout<SampleT> Layout;
+
+    void init(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy, bool isTypeInt);
+    void layout();
+    void inValue(SampleT var);
+    void triggerSample(SampleT var, bool fresh);
+    SampleT triggerValue(float value, bool up);
+    void finishInput(uint16_t changed);
+    bool pushWindow(const SampleT *row, uint8_t stride, bool fresh);
+    void prepareProjection();
+    void project(uint16_t i);
+    u8g2_uint_t projectValue(SampleT var);
+    void resetArray();
+    void resetQueue();
+    void resetHistory();
+    bool record(const SampleT *row);
+    uint32_t historyOldest();
+    void queryHistory(uint32_t from, uint32_t to, SampleT &lo, SampleT &hi);
+    void queryPacked(uint32_t from, uint32_t to, SampleT &lo, SampleT &hi);
+    void packBlock();
+    void dropBlock();
+    size_t blockBytes(size_t pos);
+    void seekBlock(uint32_t block);
+    void packPut(size_t &pos, uint8_t b);
+    uint8_t packGet(size_t &pos);
+    void packWrite(size_t &pos, const SampleT &var);
+    SampleT packRead(size_t &pos);
+    static void printStage(Stream &out, const char *name, const U8g2GraphingStage &stage);
+    size_t exportRow(char *row);
+    char *exportValue(char *p, SampleT var);
+    static char *exportWord(char *p, uint32_t value, uint8_t bytes);
+#if U8G2GRAPH_STATS
+    void statStage(U8g2GraphingStage &stage, uint32_t us);
+    void statRejected(size_t n);
+
+    //Counters, renderus sums the pages of the frame being drawn since framestart.
+    U8g2GraphingStats stats = {};
+    uint32_t framestart = 0;
+    uint32_t renderus = 0;
+    bool framed = false;
+#endif
+    void buildView(uint32_t end, uint32_t first, uint16_t spc);
+    void clearColumns();
+    void drawMarkers();
+    uint16_t extremeSlot(bool largest);
+    void drawReadout(u8g2_uint_t px, u8g2_uint_t py, SampleT value, U8g2GraphingReadout &readout);
+    double columnValue(uint16_t i);
+    void statColumn(double before, double after, bool fresh);
+    void restat();
+
+    uint8_t *storage = nullptr;
+    size_t storagelen = 0;
+    uint8_t *userbuffer = nullptr;
+    size_t userlen = 0;
+    SampleT *dataset = nullptr;
+    SampleT *datalow = nullptr;
+    SampleT *colmin = nullptr;
+    SampleT *colmax = nullptr;
+    typename Traits::wide_t projlo, projhi;
+
+    //Range of the integer projection in the wide type, exact where the float
+    //minval and maxval are not (above 2^24), datalo and datahi from the window
+    //queues, rangelo and rangehi after the manual range and the widening.
+    typename Traits::wide_t datalo = 0, datahi = 0, rangelo = 0, rangehi = 0;
+    SampleT *isrvalue = nullptr;
+    uint32_t *isrtime = nullptr;
+
+    //Trigger thresholds in the sample type, the signal primes the trigger
+    //past trigprime and fires it at trigfire.
+    SampleT trigprime = 0;
+    SampleT trigfire = 0;
+
+    //Column being exported, copied when its row starts so a row split over
+    //several calls is sent whole even if the column changes in between.
+    SampleT exportcol[2 * U8G2GRAPH_MAX_SERIES];
+    uint32_t exportdt;
+
+    //History ring of histsize (2^histbits) samples, histtotal counts every recorded
+    //sample so sample t is at t & (histsize - 1). Pyramid level k holds the min and
+    //max of every aligned block of 2^k samples, level k starts at pair histsize - (histsize >> (k - 1)).
+    SampleT *history = nullptr;
+    SampleT *pyramid = nullptr;
+    bool historyowned = false;
+    uint8_t histbits = 0;
+    uint32_t histsize = 0;
+    uint32_t histtotal = 0;
+    uint32_t histtime = 0;
+    uint32_t histperiod = 0;
+
+    //Packed history, a byte ring of blocks of U8G2GRAPH_PACK_BLOCK samples, the open
+    //block is kept raw in history. A block is a header (delta bits, first sample, min, max)
+    //and the zigzag encoded deltas between its samples packed to the bits of the largest one.
+    //packhead is the header of the oldest block, packcur/packpos the block last read.
+    uint8_t *packbuf = nullptr;
+    size_t packlen = 0;
+    size_t packhead = 0;
+    size_t packused = 0;
+    size_t packpos = 0;
+    uint32_t packblocks = 0;
+    uint32_t packcur = 0;
+
+    //History view shown instead of the live columns, viewend is one past
+    //the newest sample of the view, a following view tracks the newest sample.
+    //livefill and livetotal keep the phase of the live decimated columns.
+    bool viewing = false;
+    bool viewfollow, viewdirty;
+    uint32_t viewend, livetotal;
+    uint16_t viewspc, livefill;
+
+    alignas(SampleT) uint8_t buffer[Capacity ? Layout::storageBytes(Capacity) : 1];
+};
+
+//The classic graph, float samples with begin() or integer behaviour with beginInt().
+typedef U8g2GraphingT<float> U8g2Graphing;
+
+//Constructor, takes pointer to existing U8g2 instance.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+U8g2GraphingT<SampleT, Capacity>::U8g2GraphingT(U8G2 *u8g) : U8g2GraphingBase(u8g) {}
+
+//Deconstructor, delete all data.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+U8g2GraphingT<SampleT, Capacity>::~U8g2GraphingT() {
+    resetArray();
+    resetQueue();
+    resetHistory();
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::resetArray() {
+    if (storage && storage != buffer && storage != userbuffer) {
+        delete [] storage;
+    }
+    storage = nullptr;
+    storagelen = 0;
+    dataset = nullptr;
+    datalow = nullptr;
+    colmin = nullptr;
+    colmax = nullptr;
+    minq = nullptr;
+    maxq = nullptr;
+    graph = nullptr;
+    graphlo = nullptr;
+    stamp = nullptr;
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::resetQueue() {
+    isrmask = 0;
+    delete [] isrvalue;
+    delete [] isrtime;
+    isrvalue = nullptr;
+    isrtime = nullptr;
+    isrhead = 0;
+    isrtail = 0;
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::resetHistory() {
+    if (historyowned) {
+        delete [] history;
+    }
+    history = nullptr;
+    pyramid = nullptr;
+    packbuf = nullptr;
+    packlen = 0;
+    historyowned = false;
+    histbits = 0;
+    histsize = 0;
+    histtotal = 0;
+    viewing = false;
+}
+
+//Buffer initializer, define the position and size of the graph,
+//values are treated as floating point on a float graph.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::begin(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy) {
+    init(fromx, fromy, tox, toy, Traits::isInteger);
+}
+
+//Integer buffer initializer, same as begin() but values are truncated,
+//labelled and projected as integers even on a float graph.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::beginInt(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy) {
+    init(fromx, fromy, tox, toy, true);
+}
+
+//Initialize the geometry and settings, then lay out the storage.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::init(uint16_t fromx, uint16_t fromy, uint16_t tox, uint16_t toy, bool isTypeInt) {
+    setGeometry(fromx, fromy, tox, toy);
+    resetState(isTypeInt);
+    viewing = false;
+    layout();
+    clearData();
+}
+
+//Use a caller supplied buffer (aligned for SampleT) as the storage block,
+//begin() then never allocates. bytesNeeded() gives the size for a width,
+//a smaller buffer gets fewer columns. nullptr goes back to the heap.
+//Call it before begin(), the buffer has to outlive the graph.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::bufferSet(void *buffer, size_t len) {
+    resetArray();
+    userbuffer = (uint8_t *)buffer;
+    userlen = buffer ? len : 0;
+}
+
+//Set the buffers to a single storage block, a heap block is reused
+//if it is large enough to avoid heap churn on repeated begin() calls.
+//A static or caller supplied buffer too small for the width, the envelope
+//or the series gets fewer columns instead, the plot then ends left of the
+//right edge given to begin() so the axes and labels match the columns,
+//getDataLen() tells the columns kept.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::layout() {
+    grwidth = endx - fromx - 20;
+    fixedstorage = Capacity || userbuffer;
+    if (fixedstorage) {
+        if (Capacity && grwidth > Capacity) {
+            grwidth = Capacity;
+        }
+        storage = userbuffer ? userbuffer : buffer;
+        storagelen = userbuffer ? userlen : sizeof(buffer);
+        while (Layout::storageBytes(grwidth, envelope, series) > storagelen) {
+            grwidth--;
+        }
+    } else if (Layout::storageBytes(grwidth, envelope, series) > storagelen) {
+        resetArray();
+        storagelen = Layout::storageBytes(grwidth, envelope, series);
+        storage = new uint8_t[storagelen];
+    }
+    size_t block = Layout::sampleBytes(grwidth);
+    uint8_t arrays = envelope ? 2 * series : series;
+    dataset = (SampleT *)storage;
+    datalow = envelope ? (SampleT *)(storage + series * block) : dataset;
+    colmin = (series > 1) ? (SampleT *)(storage + arrays * block) : datalow;
+    colmax = (series > 1) ? (SampleT *)(storage + (arrays + 1) * block) : dataset;
+    stamp = (uint16_t *)(storage + (arrays + ((series > 1) ? 2 : 0)) * block);
+    minq = (u8g2_uint_t *)(stamp + grwidth);
+    maxq = minq + grwidth;
+    graph = maxq + grwidth;
+    graphlo = envelope ? graph + series * grwidth : graph;
+    if (tox != fromx + 20 + grwidth) {
+        tox = fromx + 20 + grwidth;
+        tilevalid = false;
+        scrollvalid = false;
+        labelvalid = false;
+    }
+}
+
+//Set how many samples are merged into one column, 1 (default) stores every sample.
+//Each column keeps the min and max of its samples and is drawn as a vertical span,
+//so spikes between the columns are never lost. Clears the graph data.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::decimationSet(uint16_t samplesPerColumn) {
+    decim = samplesPerColumn ? samplesPerColumn : 1;
+    if (envelope != (decim > 1)) {
+        envelope = decim > 1;
+        layout();
+    }
+    labelvalid = false;
+    clearData();
+}
+
+//Set how many series the graph holds (up to U8G2GRAPH_MAX_SERIES), they share
+//the time base, the autorange, the axes and one render pass. Feed them a row of
+//one value per series with inputSeries(). Clears the graph data.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::seriesSet(uint8_t count) {
+    count = constrain(count, 1, U8G2GRAPH_MAX_SERIES);
+    if (series != count) {
+        series = count;
+        layout();
+        if (isrmask) {
+            queueSet(isrmask + 1);
+        }
+    }
+    clearData();
+}
+
+//Input value converter, clamps the value into the sample type range.
+//Not synchronized with displayGraph(), a task on another core or an interrupt
+//has to use pushFromISR() instead.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::inputValue(float var) {
+    if (Traits::isInteger) {
+        if (var <= (float)Traits::lowest()) {
+            inValue(Traits::lowest());
+        } else if (var >= (float)Traits::highest()) {
+            inValue(Traits::highest());
+        } else {
+            inValue((SampleT)var);
+        }
+    } else if (isTypeInt) {
+        inValue((SampleT)(long)var);
+    } else {
+        inValue((SampleT)var);
+    }
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::inputValue(int var) {
+    typedef typename Traits::wide_t wide_t;
+    if (Traits::isInteger && (wide_t)var < (wide_t)Traits::lowest()) {
+        inValue(Traits::lowest());
+    } else if (Traits::isInteger && (wide_t)var > (wide_t)Traits::highest()) {
+        inValue(Traits::highest());
+    } else {
+        inValue((SampleT)var);
+    }
+}
+
+//Input a value of the sample type as is, for the types float and int can not
+//hold exactly (uint32_t, int32_t on cores where it is long).
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+template <typename T>
+typename U8g2GraphingSampleInput<T, SampleT>::type U8g2GraphingT<SampleT, Capacity>::inputValue(T var) {
+    inValue(var);
+}
+
+//Input the data into the buffer and displaying the graph later,
+//works with both realtime and sampling mode, also works with U8g2 page buffer.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::inValue(SampleT var) {
+#if U8G2GRAPH_STATS
+    uint32_t start = micros();
+    if (millis() - curmil < intvl || !activate) {
+        statRejected(1);
+    }
+#endif
+    bool changed = false;
+    if (nextSample() && !record(&var)) {
+        bool fresh = nextColumn();
+        changed = pushWindow(&var, 0, fresh);
+        triggerSample(var, fresh);
+    }
+    finishInput(changed ? 1 : 0);
+#if U8G2GRAPH_STATS
+    statStage(stats.input, micros() - start);
+#endif
+}
+
+//Input one row of samples, one value per series.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::inputSeries(const SampleT *row) {
+#if U8G2GRAPH_STATS
+    uint32_t start = micros();
+    if (millis() - curmil < intvl || !activate) {
+        statRejected(1);
+    }
+#endif
+    bool changed = false;
+    if (nextSample() && !record(row)) {
+        bool fresh = nextColumn();
+        changed = pushWindow(row, 1, fresh);
+        triggerSample(row[0], fresh);
+    }
+    finishInput(changed ? 1 : 0);
+#if U8G2GRAPH_STATS
+    statStage(stats.input, micros() - start);
+#endif
+}
+
+//Input a block of samples at once, e.g. a DMA'd ADC buffer, with one timing update,
+//one range update and one projection pass for the whole block.
+//sampleIntervalUs is the period between samples, 0 spreads the time since
+//the previous input over the block. With more than one series the block
+//holds n rows of one value per series.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::inputValues(const SampleT *data, size_t n, uint32_t sampleIntervalUs) {
+#if U8G2GRAPH_STATS
+    uint32_t start = micros();
+    if (!activate) {
+        statRejected(n);
+    }
+#endif
+    if (!n || !nextBlock(n, sampleIntervalUs)) {
+        finishInput(0);
+        return;
+    }
+    if (decim == 1 && !history && !trigedge && n > grwidth) {
+        data += (n - grwidth) * series;
+        sampletime += (n - grwidth) * blockstep;
+        n = grwidth;
+    }
+    size_t changed = 0;
+    for (size_t k = 0; k < n; k++) {
+        sampletime += blockstep;
+        if (record(data + k * series)) {
+            continue;
+        }
+        bool fresh = nextColumn();
+        pushWindow(data + k * series, 1, fresh);
+        if (fresh || !k) {
+            changed++;
+        }
+        triggerSample(data[k * series], fresh);
+        if (!activate) {
+            break;
+        }
+    }
+    finishInput((changed > grwidth) ? grwidth : changed);
+#if U8G2GRAPH_STATS
+    statStage(stats.input, micros() - start);
+#endif
+}
+
+//Set the size of the interrupt sample queue, rounded down to a power of two
+//up to U8G2GRAPH_QUEUE_MAX entries, one entry is kept free to tell a full queue
+//from an empty one. 0 removes the queue. Call it before the interrupt is enabled.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::queueSet(uint16_t size) {
+    resetQueue();
+    if (size < 2) {
+        return;
+    }
+    uint16_t len = 2;
+    while (len * 2 <= size && len < U8G2GRAPH_QUEUE_MAX) {
+        len *= 2;
+    }
+    isrvalue = new SampleT[len * series];
+    isrtime = new uint32_t[len];
+    isrmask = len - 1;
+}
+
+//Queue a sample from an interrupt or timer callback, timestamp is in µs
+//(e.g. micros() or a hardware timer count). Only stores the sample,
+//the range and projection work is done by update() or displayGraph().
+//Returns false if the queue is full (or not set) and the sample is dropped.
+//It is also the way to feed the graph from a task on another core: the
+//producer never waits and every frame is drawn from a consistent state, as
+//only the task calling displayGraph() changes the graph. One producer only.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+bool U8g2GraphingT<SampleT, Capacity>::pushFromISR(SampleT value, uint32_t timestamp) {
+    U8g2GraphingQueueIndex head = isrhead;
+    U8g2GraphingQueueIndex next = (head + 1) & isrmask;
+    //The consumer has to be done with the entry before it is written again.
+    if (next == queueAcquire(isrtail)) {
+#if U8G2GRAPH_STATS
+        stats.dropped++;
+#endif
+        return false;
+    }
+    for (uint8_t s = 0; s < series; s++) {
+        isrvalue[head * series + s] = value;
+    }
+    isrtime[head] = timestamp;
+    //The entry has to be complete before the consumer can see the new head.
+    queueRelease(isrhead, next);
+    return true;
+}
+
+//Queue a row of samples, one value per series.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+bool U8g2GraphingT<SampleT, Capacity>::pushFromISR(const SampleT *row, uint32_t timestamp) {
+    U8g2GraphingQueueIndex head = isrhead;
+    U8g2GraphingQueueIndex next = (head + 1) & isrmask;
+    //The consumer has to be done with the entry before it is written again.
+    if (next == queueAcquire(isrtail)) {
+#if U8G2GRAPH_STATS
+        stats.dropped++;
+#endif
+        return false;
+    }
+    for (uint8_t s = 0; s < series; s++) {
+        isrvalue[head * series + s] = row[s];
+    }
+    isrtime[head] = timestamp;
+    //The entry has to be complete before the consumer can see the new head.
+    queueRelease(isrhead, next);
+    return true;
+}
+
+//Drain the interrupt sample queue into the graph in one pass, the column times
+//come from the timestamps so the interval set by intervalSet() is not applied.
+//Called by displayGraph(), can also be called from loop() to keep the queue short.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::update() {
+    U8g2GraphingQueueIndex head = queueAcquire(isrhead);
+#if U8G2GRAPH_STATS
+    bool drained = (isrtail != head);
+    uint32_t start = micros();
+    if (!activate) {
+        statRejected((U8g2GraphingQueueIndex)(head - isrtail) & isrmask);
+    }
+#endif
+    size_t changed = 0;
+    while (isrtail != head) {
+        U8g2GraphingQueueIndex tail = isrtail;
+        if (nextStamp(isrtime[tail]) && !record(isrvalue + tail * series)) {
+            bool fresh = nextColumn();
+            if (pushWindow(isrvalue + tail * series, 1, fresh) && (fresh || !changed)) {
+                changed++;
+            }
+            triggerSample(isrvalue[tail * series], fresh);
+        }
+        //The entry has to be consumed before the producer can reuse it.
+        queueRelease(isrtail, (tail + 1) & isrmask);
+    }
+    finishInput((changed > grwidth) ? grwidth : changed);
+#if U8G2GRAPH_STATS
+    if (drained) {
+        statStage(stats.input, micros() - start);
+    }
+#endif
+}
+
+//Capture one screen around a trigger, like the single shot mode of an oscilloscope.
+//The graph fills as usual until the first series crosses level on the given edge,
+//after having been at least hysteresis past it on the other side, then stops once
+//the columns after the trigger fill the screen. pretrigger is the part of the
+//screen before the trigger column (0 to 1). triggerArm() waits for the next one.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::triggerSet(U8g2GraphingTrigger edge, float level, float hysteresis, float pretrigger) {
+    trigedge = edge;
+    bool rising = (edge == U8G2GRAPH_TRIGGER_RISING);
+    trigfire = triggerValue(level, rising);
+    trigprime = triggerValue(rising ? level - hysteresis : level + hysteresis, rising);
+    trigpre = (uint16_t)(constrain(pretrigger, 0, 1) * (grwidth - 1) + 0.5f);
+    scrollvalid = false;
+    triggerArm();
+}
+
+//Threshold of a trigger in the sample type, rounded up for a rising edge
+//and down for a falling one so the integer compare matches the float level.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+SampleT U8g2GraphingT<SampleT, Capacity>::triggerValue(float value, bool up) {
+    if (!Traits::isInteger) {
+        return (SampleT)value;
+    }
+    if (value <= (float)Traits::lowest()) {
+        return Traits::lowest();
+    }
+    if (value >= (float)Traits::highest()) {
+        return Traits::highest();
+    }
+    SampleT var = (SampleT)value;
+    if (up && (float)var < value) {
+        var++;
+    } else if (!up && (float)var > value) {
+        var--;
+    }
+    return var;
+}
+
+//Trigger state of a stored sample, a couple of compares per sample.
+//Stops the input when the capture is complete.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::triggerSample(SampleT var, bool fresh) {
+    if (!trigedge || trigfrozen) {
+        return;
+    }
+    bool rising = (trigedge == U8G2GRAPH_TRIGGER_RISING);
+    if (!trigfired) {
+        if (fresh && trigcount < grwidth) {
+            trigcount++;
+        }
+        if (rising ? var < trigprime : var > trigprime) {
+            trigprimed = true;
+        } else if (trigprimed && trigcount > trigpre && (rising ? var >= trigfire : var <= trigfire)) {
+            trigfired = true;
+            trigslot = ndx;
+            trigcount = grwidth - 1 - trigpre;
+            fresh = false;
+        }
+    }
+    if (trigfired) {
+        if (fresh) {
+            trigcount--;
+        }
+        if (!trigcount && !decimfill) {
+            trigfrozen = true;
+            activate = false;
+        }
+    }
+}
+
+//Keep a history of the last samples (rounded down to a power of two) on the heap,
+//setView() can then show any part of it at any zoom. 0 removes the history.
+//The history records single series graphs. Clears the history.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::historySet(uint32_t samples) {
+    resetHistory();
+    if (samples < 2) {
+        return;
+    }
+    uint32_t len = 2;
+    while (len * 2 <= samples) {
+        len *= 2;
+    }
+    historySet(new SampleT[historyBytes(len) / sizeof(SampleT)], historyBytes(len));
+    historyowned = true;
+}
+
+//Keep the history in a caller supplied buffer (aligned for SampleT), e.g. PSRAM
+//on ESP32, it holds the largest power of two samples historyBytes() fits in len.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::historySet(void *buffer, size_t len) {
+    resetHistory();
+    if (!buffer || len < historyBytes(2)) {
+        return;
+    }
+    histsize = 2;
+    histbits = 1;
+    while (historyBytes(histsize * 2) <= len) {
+        histsize *= 2;
+        histbits++;
+    }
+    history = (SampleT *)buffer;
+    pyramid = history + histsize;
+}
+
+//Keep a packed history of the given number of bytes on the heap, integer graphs only.
+//Samples are delta encoded in blocks, a slowly changing signal takes a few bits
+//per sample, so the same RAM holds several times the samples of historySet().
+//The oldest blocks are dropped when the buffer is full. Clears the history.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::historyPackedSet(size_t bytes) {
+    resetHistory();
+    if (bytes < packedBytes()) {
+        return;
+    }
+    historyPackedSet(new SampleT[(bytes + sizeof(SampleT) - 1) / sizeof(SampleT)], bytes);
+    historyowned = true;
+}
+
+//Keep a packed history in a caller supplied buffer (aligned for SampleT),
+//len has to be at least packedBytes().
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::historyPackedSet(void *buffer, size_t len) {
+    static_assert(Traits::isInteger, "packed history needs an integer sample type");
+    resetHistory();
+    if (!buffer || len < packedBytes()) {
+        return;
+    }
+    history = (SampleT *)buffer;
+    packbuf = (uint8_t *)(history + U8G2GRAPH_PACK_BLOCK);
+    packlen = len - U8G2GRAPH_PACK_BLOCK * sizeof(SampleT);
+    packhead = 0;
+    packused = 0;
+    packblocks = 0;
+    packcur = 0;
+    packpos = 0;
+}
+
+//Return the number of samples in the history.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+uint32_t U8g2GraphingT<SampleT, Capacity>::getHistoryLen() {
+    return histtotal - historyOldest();
+}
+
+//Return the index of the oldest sample still in the history.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+uint32_t U8g2GraphingT<SampleT, Capacity>::historyOldest() {
+    if (packbuf) {
+        return (histtotal / U8G2GRAPH_PACK_BLOCK - packblocks) * U8G2GRAPH_PACK_BLOCK;
+    }
+    return (histtotal > histsize) ? histtotal - histsize : 0;
+}
+
+//Show the history instead of the live graph, offset is the number of samples
+//between the newest one and the right edge, in the same right to left order
+//as pointerSetI(). Every column shows the min and max of samplesPerColumn samples
+//read from the pyramid, so the cost depends on the graph width, not the zoom.
+//An offset of 0 keeps following the newest sample, samplesPerColumn 0 goes back
+//to the live graph. Samples keep going into the history while a view is shown.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::setView(uint32_t offset, uint16_t samplesPerColumn) {
+    if (!history || series > 1) {
+        return;
+    }
+    if (!samplesPerColumn) {
+        if (!viewing) {
+            return;
+        }
+        viewing = false;
+        if (envelope != (decim > 1)) {
+            envelope = decim > 1;
+            layout();
+        }
+        uint16_t fill = (livefill + (histtotal - livetotal) % decim) % decim;
+        buildView(histtotal, fill ? fill : decim, decim);
+        decimfill = fill;
+        return;
+    }
+    if (!viewing) {
+        livefill = decimfill;
+        livetotal = histtotal;
+    }
+    viewing = true;
+    viewfollow = (offset == 0);
+    viewdirty = false;
+    viewspc = samplesPerColumn;
+    viewend = histtotal - ((offset < histtotal) ? offset : histtotal);
+    if (envelope != (samplesPerColumn > 1)) {
+        envelope = samplesPerColumn > 1;
+        layout();
+    }
+    uint32_t first = viewend % viewspc;
+    buildView(viewend, (viewfollow && first) ? first : viewspc, viewspc);
+}
+
+//Add a sample to the history and its pyramid, O(log n) per sample.
+//Returns true while a view is shown, the live columns are then left alone.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+bool U8g2GraphingT<SampleT, Capacity>::record(const SampleT *row) {
+    if (history && series == 1) {
+        SampleT var = row[0];
+        if (!Traits::isInteger && isTypeInt) {
+            var = (SampleT)(long)var;
+        }
+        uint32_t t = histtotal;
+        if (packbuf) {
+            history[t & (U8G2GRAPH_PACK_BLOCK - 1)] = var;
+            if ((t & (U8G2GRAPH_PACK_BLOCK - 1)) == U8G2GRAPH_PACK_BLOCK - 1) {
+                packBlock();
+            }
+        } else {
+            history[t & (histsize - 1)] = var;
+        }
+        for (uint8_t k = 1; k <= histbits; k++) {
+            SampleT *pair = pyramid + 2 * ((histsize - (histsize >> (k - 1))) + ((t >> k) & ((histsize >> k) - 1)));
+            if (!(t & (((uint32_t)1 << k) - 1))) {
+                pair[0] = var;
+                pair[1] = var;
+            } else if (var < pair[0]) {
+                pair[0] = var;
+            } else if (var > pair[1]) {
+                pair[1] = var;
+            }
+        }
+        //Mean sample period for the column times of the views.
+        uint32_t period = sampletime - histtime;
+        histperiod = t ? histperiod + ((long)period - (long)histperiod) / 8 : 0;
+        histtime = sampletime;
+        histtotal++;
+        viewdirty = true;
+    }
+    return viewing;
+}
+
+//Min and max of the history samples [from, to), read as the largest
+//aligned pyramid blocks, O(log n) blocks per range.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::queryHistory(uint32_t from, uint32_t to, SampleT &lo, SampleT &hi) {
+    if (packbuf) {
+        queryPacked(from, to, lo, hi);
+        return;
+    }
+    lo = history[from & (histsize - 1)];
+    hi = lo;
+    while (from < to) {
+        uint8_t k = 0;
+        while (k < histbits && !(from & ((uint32_t)1 << k)) && from + ((uint32_t)2 << k) <= to) {
+            k++;
+        }
+        SampleT a, b;
+        if (k) {
+            SampleT *pair = pyramid + 2 * ((histsize - (histsize >> (k - 1))) + ((from >> k) & ((histsize >> k) - 1)));
+            a = pair[0];
+            b = pair[1];
+        } else {
+            a = history[from & (histsize - 1)];
+            b = a;
+        }
+        if (a < lo) {
+            lo = a;
+        }
+        if (b > hi) {
+            hi = b;
+        }
+        from += (uint32_t)1 << k;
+    }
+}
+
+//Min and max of the packed history samples [from, to), whole blocks are read
+//from their header, a partial block is decoded from its first sample on.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::queryPacked(uint32_t from, uint32_t to, SampleT &lo, SampleT &hi) {
+    typedef typename Traits::wide_t wide_t;
+    uint32_t open = histtotal & ~(uint32_t)(U8G2GRAPH_PACK_BLOCK - 1);
+    bool first = true;
+    while (from < to) {
+        SampleT a, b;
+        uint32_t next;
+        if (from >= open) {
+            a = history[from & (U8G2GRAPH_PACK_BLOCK - 1)];
+            b = a;
+            next = from + 1;
+        } else {
+            uint32_t start = from & ~(uint32_t)(U8G2GRAPH_PACK_BLOCK - 1);
+            next = (to < start + U8G2GRAPH_PACK_BLOCK) ? to : start + U8G2GRAPH_PACK_BLOCK;
+            seekBlock(start / U8G2GRAPH_PACK_BLOCK);
+            size_t pos = packpos;
+            uint8_t bits = packGet(pos);
+            SampleT var = packRead(pos);
+            a = packRead(pos);
+            b = packRead(pos);
+            if (from != start || next != start + U8G2GRAPH_PACK_BLOCK) {
+                uint8_t acc = 0;
+                uint8_t nacc = 0;
+                for (uint32_t t = start; t < next; t++) {
+                    if (t > start) {
+                        wide_t z = 0;
+                        for (uint8_t got = 0; got < bits;) {
+                            if (!nacc) {
+                                acc = packGet(pos);
+                                nacc = 8;
+                            }
+                            uint8_t take = (nacc < bits - got) ? nacc : bits - got;
+                            z |= (wide_t)(acc & ((1 << take) - 1)) << got;
+                            acc >>= take;
+                            nacc -= take;
+                            got += take;
+                        }
+                        var = (SampleT)((wide_t)var + ((z & 1) ? -(z >> 1) - 1 : z >> 1));
+                    }
+                    if (t == from) {
+                        a = var;
+                        b = var;
+                    } else if (t > from && var < a) {
+                        a = var;
+                    } else if (t > from && var > b) {
+                        b = var;
+                    }
+                }
+            }
+        }
+        if (first || a < lo) {
+            lo = a;
+        }
+        if (first || b > hi) {
+            hi = b;
+        }
+        first = false;
+        from = next;
+    }
+}
+
+//Encode the full open block into the packed ring, the oldest blocks
+//are dropped until it fits.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::packBlock() {
+    typedef typename Traits::wide_t wide_t;
+    SampleT lo = history[0];
+    SampleT hi = history[0];
+    wide_t top = 0;
+    for (uint8_t i = 1; i < U8G2GRAPH_PACK_BLOCK; i++) {
+        wide_t d = (wide_t)history[i] - (wide_t)history[i - 1];
+        top |= (d < 0) ? ((-d) << 1) - 1 : d << 1;
+        if (history[i] < lo) {
+            lo = history[i];
+        } else if (history[i] > hi) {
+            hi = history[i];
+        }
+    }
+    uint8_t bits = 0;
+    while (top >> bits) {
+        bits++;
+    }
+    size_t need = 1 + 3 * sizeof(SampleT) + (bits * (U8G2GRAPH_PACK_BLOCK - 1) + 7) / 8;
+    while (packlen - packused < need) {
+        dropBlock();
+    }
+
+    size_t pos = (packhead + packused) % packlen;
+    packPut(pos, bits);
+    packWrite(pos, history[0]);
+    packWrite(pos, lo);
+    packWrite(pos, hi);
+    uint8_t acc = 0;
+    uint8_t nacc = 0;
+    for (uint8_t i = 1; i < U8G2GRAPH_PACK_BLOCK; i++) {
+        wide_t d = (wide_t)history[i] - (wide_t)history[i - 1];
+        wide_t z = (d < 0) ? ((-d) << 1) - 1 : d << 1;
+        for (uint8_t left = bits; left;) {
+            uint8_t take = (8 - nacc < left) ? 8 - nacc : left;
+            acc |= (uint8_t)((z & ((1 << take) - 1)) << nacc);
+            z >>= take;
+            left -= take;
+            nacc += take;
+            if (nacc == 8) {
+                packPut(pos, acc);
+                acc = 0;
+                nacc = 0;
+            }
+        }
+    }
+    if (nacc) {
+        packPut(pos, acc);
+    }
+    packused += need;
+    packblocks++;
+}
+
+//Drop the oldest block of the packed ring.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::dropBlock() {
+    size_t len = blockBytes(packhead);
+    packhead = (packhead + len) % packlen;
+    packused -= len;
+    packblocks--;
+}
+
+//Return the bytes of the block starting at pos, read from its header.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+size_t U8g2GraphingT<SampleT, Capacity>::blockBytes(size_t pos) {
+    uint8_t bits = packGet(pos);
+    return 1 + 3 * sizeof(SampleT) + (bits * (U8G2GRAPH_PACK_BLOCK - 1) + 7) / 8;
+}
+
+//Move the block cursor to the given block, sequential queries only walk forward.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::seekBlock(uint32_t block) {
+    uint32_t oldest = histtotal / U8G2GRAPH_PACK_BLOCK - packblocks;
+    if (block < packcur || packcur < oldest) {
+        packcur = oldest;
+        packpos = packhead;
+    }
+    while (packcur < block) {
+        packpos = (packpos + blockBytes(packpos)) % packlen;
+        packcur++;
+    }
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::packPut(size_t &pos, uint8_t b) {
+    packbuf[pos] = b;
+    pos = (pos + 1 == packlen) ? 0 : pos + 1;
+}
+
+template <typename SampleT, uint16_t Capacity>
+uint8_t U8g2GraphingT<SampleT, Capacity>::packGet(size_t &pos) {
+    uint8_t b = packbuf[pos];
+    pos = (pos + 1 == packlen) ? 0 : pos + 1;
+    return b;
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::packWrite(size_t &pos, const SampleT &var) {
+    const uint8_t *b = (const uint8_t *)&var;
+    for (uint8_t i = 0; i < sizeof(SampleT); i++) {
+        packPut(pos, b[i]);
+    }
+}
+
+template <typename SampleT, uint16_t Capacity>
+SampleT U8g2GraphingT<SampleT, Capacity>::packRead(size_t &pos) {
+    SampleT var;
+    uint8_t *b = (uint8_t *)&var;
+    for (uint8_t i = 0; i < sizeof(SampleT); i++) {
+        b[i] = packGet(pos);
+    }
+    return var;
+}
+
+//Rebuild the columns from the history, the newest column holds the first samples
+//before end and every older one spc samples. Columns older than the history stay empty.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::buildView(uint32_t end, uint32_t first, uint16_t spc) {
+    uint32_t oldest = historyOldest();
+    clearColumns();
+    uint16_t n = 0;
+    while (n < grwidth && end >= oldest + first + (uint32_t)n * spc) {
+        n++;
+    }
+    uint32_t period = histperiod * spc;
+    sampletime = histtime - period * ((n > 0) ? n - 1 : 0);
+    for (uint16_t c = n; c-- > 0;) {
+        uint32_t from = end - first - (uint32_t)c * spc;
+        SampleT lo, hi;
+        queryHistory(from, from + (c ? spc : first), lo, hi);
+        decimfill = 0;
+        pushWindow(&hi, 0, nextColumn());
+        if (lo < hi) {
+            pushWindow(&lo, 0, false);
+        }
+        sampletime += period;
+    }
+    viewdirty = false;
+    finishInput(n);
+}
+
+//Update the range from the window queues and project the changed newest columns,
+//every column is only projected again when the range or layout changed.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::finishInput(uint16_t changed) {
+    typedef typename Traits::wide_t wide_t;
+    if (changed) {
+        minval = colmin[minq[minhead]];
+        maxval = colmax[maxq[maxhead]];
+        mindata = minval;
+        maxdata = maxval;
+        datalo = (wide_t)colmin[minq[minhead]];
+        datahi = (wide_t)colmax[maxq[maxhead]];
+    }
+
+    applyRange();
+    if (Traits::isInteger || isTypeInt) {
+        wide_t lo = autorange ? datalo : (wide_t)vmin;
+        wide_t hi = autorange ? datahi : (wide_t)vmax;
+        if (hi == lo) {
+            hi++;
+            lo--;
+        }
+        if (lo != rangelo || hi != rangehi) {
+            rangelo = lo;
+            rangehi = hi;
+            projvalid = false;
+        }
+        minval = (float)rangelo;
+        maxval = (float)rangehi;
+    }
+
+    if (rangeChanged()) {
+        prepareProjection();
+        for (uint16_t i = 0; i < grwidth; i++) {
+            project(i);
+        }
+    } else {
+        uint16_t i = ndx;
+        for (uint16_t n = 0; n < changed; n++) {
+            project(i);
+            i = (i == 0) ? grwidth - 1 : i - 1;
+        }
+    }
+}
+
+//Store a row at the ring head and update the monotonic min/max queues,
+//the queues hold ring slots ordered by age so each column is pushed and
+//popped at most once, giving amortized O(1) autorange per sample.
+//Series s reads row[s * stride], a stride of 0 gives every series the same value.
+//A row merged into the newest column (fresh false) widens its envelope,
+//the column is always the back of both queues so it is just pushed again.
+//Returns false if the row did not change the column.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+bool U8g2GraphingT<SampleT, Capacity>::pushWindow(const SampleT *row, uint8_t stride, bool fresh) {
+    bool changed = fresh;
+    SampleT lo = 0;
+    SampleT hi = 0;
+    double before = columnValue(ndx);
+    for (uint8_t s = 0; s < series; s++) {
+        uint16_t slot = s * grwidth + ndx;
+        SampleT var = row[s * stride];
+        if (!Traits::isInteger && isTypeInt) {
+            var = (SampleT)(long)var;
+        }
+        if (fresh) {
+            dataset[slot] = var;
+            datalow[slot] = var;
+        } else if (var > dataset[slot]) {
+            dataset[slot] = var;
+            changed = true;
+        } else if (var < datalow[slot]) {
+            datalow[slot] = var;
+            changed = true;
+        }
+        if (!s || datalow[slot] < lo) {
+            lo = datalow[slot];
+        }
+        if (!s || dataset[slot] > hi) {
+            hi = dataset[slot];
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+    statColumn(before, columnValue(ndx), fresh);
+
+    if (fresh) {
+        if (minlen && minq[minhead] == ndx) {
+            minhead = (minhead + 1 >= grwidth) ? 0 : minhead + 1;
+            minlen--;
+        }
+        if (maxlen && maxq[maxhead] == ndx) {
+            maxhead = (maxhead + 1 >= grwidth) ? 0 : maxhead + 1;
+            maxlen--;
+        }
+    } else {
+        minlen--;
+        maxlen--;
+    }
+
+    colmin[ndx] = lo;
+    colmax[ndx] = hi;
+
+    while (minlen) {
+        uint16_t back = minhead + minlen - 1;
+        if (back >= grwidth) {
+            back -= grwidth;
+        }
+        if (colmin[minq[back]] < lo) {
+            break;
+        }
+        minlen--;
+    }
+    uint16_t mintail = minhead + minlen;
+    if (mintail >= grwidth) {
+        mintail -= grwidth;
+    }
+    minq[mintail] = ndx;
+    minlen++;
+
+    while (maxlen) {
+        uint16_t back = maxhead + maxlen - 1;
+        if (back >= grwidth) {
+            back -= grwidth;
+        }
+        if (colmax[maxq[back]] > hi) {
+            break;
+        }
+        maxlen--;
+    }
+    uint16_t maxtail = maxhead + maxlen;
+    if (maxtail >= grwidth) {
+        maxtail -= grwidth;
+    }
+    maxq[maxtail] = ndx;
+    maxlen++;
+    return true;
+}
+
+//Value of column i of the first series for the running statistics.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+double U8g2GraphingT<SampleT, Capacity>::columnValue(uint16_t i) {
+    if (envelope) {
+        return ((double)dataset[i] + (double)datalow[i]) / 2;
+    }
+    return (double)dataset[i];
+}
+
+//Replace the contribution of the newest column to the running sums,
+//a fresh column on a full ring also removes the oldest one it overwrote.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::statColumn(double before, double after, bool fresh) {
+    if (fresh && statn < grwidth) {
+        statn++;
+    } else {
+        before -= statref;
+        statsum -= before;
+        statsq -= before * before;
+    }
+    after -= statref;
+    statsum += after;
+    statsq += after * after;
+    if (++statfix >= 4 * grwidth) {
+        restat();
+    }
+}
+
+//Rebuild the running sums from the columns around the current mean,
+//O(width) every 4 widths of column updates.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::restat() {
+    statref = statn ? statref + statsum / statn : 0;
+    statsum = 0;
+    statsq = 0;
+    uint16_t i = ndx;
+    for (uint16_t n = 0; n < statn; n++) {
+        double d = columnValue(i) - statref;
+        statsum += d;
+        statsq += d * d;
+        i = (i == 0) ? grwidth - 1 : i - 1;
+    }
+    statfix = 0;
+}
+
+//Compute the fixed-point scale for the current range, integer data is pre-shifted
+//so the offset fits 16 bits and offset * scale stays inside 32 bits.
+//The integer scale is rounded up so exact rows are not truncated one short.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::prepareProjection() {
+    projfixed = fixedpoint && maxval > minval;
+    if (!projfixed) {
+        return;
+    }
+    uint32_t rows = projbottom - fromy;
+    projshift = fixedShift();
+    projpre = 0;
+    if (Traits::isInteger || isTypeInt) {
+        projlo = rangelo;
+        projhi = rangehi;
+        if (projhi <= projlo) {
+            projfixed = false;
+            return;
+        }
+        uint32_t span = (uint32_t)(projhi - projlo);
+        while ((span >> projpre) > 0xFFFF) {
+            projpre++;
+        }
+        span >>= projpre;
+        projscale = ((rows << projshift) + span - 1) / span;
+        projround = 0;
+    } else {
+        projscalef = (float)(rows << projshift) / (maxval - minval);
+        projround = ((uint32_t)1 << projshift) - 1;
+    }
+}
+
+//Project one column of every series to its pixel rows, the envelope minimum included.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::project(uint16_t i) {
+    for (uint16_t slot = i; slot < series * grwidth; slot += grwidth) {
+        graph[slot] = projectValue(dataset[slot]);
+        if (envelope) {
+            graphlo[slot] = projectValue(datalow[slot]);
+        }
+    }
+}
+
+//Project one value to its pixel row, integer types never touch floats.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+u8g2_uint_t U8g2GraphingT<SampleT, Capacity>::projectValue(SampleT var) {
+    long posy;
+    if (projfixed) {
+        uint32_t q;
+        if (Traits::isInteger || isTypeInt) {
+            typename Traits::wide_t v = (typename Traits::wide_t)var;
+            v = constrain(v, projlo, projhi);
+            q = ((uint32_t)(v - projlo) >> projpre) * projscale;
+        } else {
+            float v = constrain(var, minval, maxval);
+            q = (uint32_t)((v - minval) * projscalef);
+        }
+        posy = (long)projbottom - (long)((q + projround) >> projshift);
+    } else if (Traits::isInteger) {
+        typedef typename Traits::wide_t wide_t;
+        posy = (long)(((wide_t)var - rangelo) * ((wide_t)fromy - (wide_t)projbottom) / (rangehi - rangelo)) + projbottom;
+    } else if (isTypeInt) {
+        posy = map((long)var, (long)rangelo, (long)rangehi, projbottom, fromy);
+    } else {
+        float posf = fmap(var, minval, maxval, projbottom, fromy);
+        posy = (posf < fromy) ? fromy : (posf > projbottom) ? projbottom : (long)posf;
+    }
+    return constrain(posy, (long)fromy, (long)projbottom);
+}
+
+//Clear graph data and the history.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::clearData() {
+    if (viewing) {
+        viewing = false;
+        if (envelope != (decim > 1)) {
+            envelope = decim > 1;
+            layout();
+        }
+    }
+    if (!trigfrozen) {
+        trigfired = false;
+        trigprimed = false;
+        trigcount = 0;
+    }
+    histtotal = 0;
+    packhead = 0;
+    packused = 0;
+    packblocks = 0;
+    packcur = 0;
+    packpos = 0;
+    clearColumns();
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::clearColumns() {
+    for (uint16_t i = 0; i < series * grwidth; i++) {
+        dataset[i] = 0;
+        datalow[i] = 0;
+        graph[i] = toy;
+        graphlo[i] = toy;
+    }
+    for (uint16_t i = 0; i < grwidth; i++) {
+        colmin[i] = 0;
+        colmax[i] = 0;
+        stamp[i] = 0;
+    }
+    count = 0;
+    spanus = 0;
+    midus = 0;
+    statref = 0;
+    statsum = 0;
+    statsq = 0;
+    statn = 0;
+    statfix = 0;
+    labelvalid = false;
+    decimfill = 0;
+    resetWindow();
+    datalo = 0;
+    datahi = 0;
+    projvalid = false;
+}
+
+//Standalone function to display the graph.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::displayGraph() {
+#if U8G2GRAPH_STATS
+    uint32_t start = micros();
+    if (u8g2->getBufferCurrTileRow() == 0) {
+        if (framed) {
+            statStage(stats.frame, start - framestart);
+            statStage(stats.render, renderus);
+        }
+        framed = true;
+        framestart = start;
+        renderus = 0;
+    }
+#endif
+    if (u8g2->getBufferCurrTileRow() == 0) {
+        update();
+        if (viewing && viewfollow && viewdirty) {
+            uint32_t first = histtotal % viewspc;
+            buildView(histtotal, first ? first : viewspc, viewspc);
+        }
+    }
+    beginPage();
+    drawGraph();
+    drawAxes();
+
+    uint16_t i;
+    u8g2_uint_t px;
+    if (pointer && pointerSlot(_pointndx, i, px)) {
+        drawReadout(px, graph[i], dataset[i], ptrreadout);
+    }
+    if (count) {
+        drawMarkers();
+    }
+    if (trigfired && !viewing) {
+        drawTrigger();
+    }
+#if U8G2GRAPH_STATS
+    renderus += micros() - start;
+#endif
+}
+
+//Draw the markers over the plot, each keeps its readout formatted until its value changes.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::drawMarkers() {
+    uint16_t i;
+    u8g2_uint_t px;
+    for (uint8_t m = 0; m < U8G2GRAPH_MAX_MARKERS; m++) {
+        switch (markertype[m]) {
+            case U8G2GRAPH_MARKER_CURSOR:
+                if (pointerSlot((uint16_t)markerpos[m], i, px)) {
+                    drawReadout(px, graph[i], dataset[i], markerreadout[m]);
+                }
+                break;
+            case U8G2GRAPH_MARKER_LEVEL:
+                drawLevel(markerpos[m], markerreadout[m]);
+                break;
+            case U8G2GRAPH_MARKER_MIN:
+                if (count) {
+                    i = extremeSlot(false);
+                    drawReadout(slotX(i), projectValue(colmin[i]), colmin[i], markerreadout[m]);
+                }
+                break;
+            case U8G2GRAPH_MARKER_MAX:
+                if (count) {
+                    i = extremeSlot(true);
+                    drawReadout(slotX(i), projectValue(colmax[i]), colmax[i], markerreadout[m]);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+//Ring slot of the smallest or largest filled column, the window queues are
+//used unless their head is the empty column the window starts with, which
+//stays in the autorange until the ring wraps, then the filled ones are scanned.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+uint16_t U8g2GraphingT<SampleT, Capacity>::extremeSlot(bool largest) {
+    uint16_t best = largest ? maxq[maxhead] : minq[minhead];
+    if ((ndx + grwidth - best) % grwidth < count) {
+        return best;
+    }
+    best = ndx;
+    uint16_t i = ndx;
+    for (uint16_t n = 1; n < count; n++) {
+        i = (i == 0) ? grwidth - 1 : i - 1;
+        if (largest ? colmax[i] > colmax[best] : colmin[i] < colmin[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+//Draw a readout box pointing at a column, skipped on pages it does not reach.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::drawReadout(u8g2_uint_t px, u8g2_uint_t py, SampleT value, U8g2GraphingReadout &readout) {
+    if (!inPage(fromx, (py > 15) ? py - 15 : 0, tox, py + 15)) {
+        return;
+    }
+    if (Traits::isInteger || isTypeInt) {
+        drawPointerInt(px, py, (long)value, readout);
+    } else {
+        drawPointerFloat(px, py, value, readout);
+    }
+}
+
+//Start sending the columns on the graph to exportData(), oldest to newest.
+//CSV starts with a line of the column count, series, decimation and sampling
+//interval in ms, then the field names, then one row per column: its index,
+//the µs since the previous column and the value of every series (the min and
+//max of every series on a decimated graph). Binary sends the same as a 16 byte
+//header ('U', '8', 'G', 1, sample bytes, flags, series, record bytes, columns,
+//decimation, interval) and fixed size records, integers are little endian.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::exportStart(U8g2GraphingExport format) {
+    exportformat = format;
+    exportfirst = colserial - count + 1;
+    exportnext = exportfirst;
+    exportlast = colserial;
+    exportstage = 0;
+    exportpos = 0;
+    exporting = true;
+}
+
+//Send the next part of the export started by exportStart(), as many bytes as
+//fit in maxBytes (or in out.availableForWrite() if 0) so it never waits for the
+//stream, a row longer than that is split over several calls. Call it from loop()
+//until it returns U8G2GRAPH_EXPORT_DONE (0). WAITING means no room on this call,
+//it is tried again on the next one. Streams that always report 0 from
+//availableForWrite() (the Print default, SoftwareSerial, File) keep WAITING and
+//need maxBytes. Columns that scrolled off the graph before they were sent are
+//skipped, the row index tells the gap.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+U8g2GraphingExportState U8g2GraphingT<SampleT, Capacity>::exportData(Stream &out, size_t maxBytes) {
+    size_t budget = maxBytes ? maxBytes : out.availableForWrite();
+    bool sent = false;
+    char row[24 + 2 * U8G2GRAPH_MAX_SERIES * 17];
+    while (exporting && budget) {
+        size_t len = exportRow(row);
+        if (!len) {
+            exporting = false;
+            break;
+        }
+        size_t part = len - exportpos;
+        sent = true;
+        if (part > budget) {
+            out.write((const uint8_t *)row + exportpos, budget);
+            exportpos += budget;
+            break;
+        }
+        out.write((const uint8_t *)row + exportpos, part);
+        budget -= part;
+        exportpos = 0;
+        if (exportstage < 2) {
+            exportstage = (exportformat == U8G2GRAPH_EXPORT_BINARY) ? 2 : exportstage + 1;
+        } else {
+            exportnext++;
+        }
+    }
+    if (!exporting) {
+        return U8G2GRAPH_EXPORT_DONE;
+    }
+    return sent ? U8G2GRAPH_EXPORT_SENDING : U8G2GRAPH_EXPORT_WAITING;
+}
+
+//Format the next header line or column of the export, returns its length, 0 when done.
+//A column row is formatted from the copy taken when its first byte was sent.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+size_t U8g2GraphingT<SampleT, Capacity>::exportRow(char *row) {
+    uint8_t values = envelope ? 2 * series : series;
+    bool binary = (exportformat == U8G2GRAPH_EXPORT_BINARY);
+    char *p = row;
+    if (exportstage == 0) {
+        if (binary) {
+            *p++ = 'U';
+            *p++ = '8';
+            *p++ = 'G';
+            *p++ = 1;
+            *p++ = sizeof(SampleT);
+            *p++ = (Traits::isInteger ? 1 : 0) | (envelope ? 2 : 0) | (isTypeInt ? 4 : 0);
+            *p++ = series;
+            *p++ = 6 + values * sizeof(SampleT);
+            p = exportWord(p, exportlast - exportfirst + 1, 2);
+            p = exportWord(p, decim, 2);
+            p = exportWord(p, intvl, 4);
+        } else {
+            p += sprintf(p, "#columns=%u,series=%u,decimation=%u,interval_ms=%lu\n",
+                         (unsigned)(exportlast - exportfirst + 1), (unsigned)series, (unsigned)decim, (unsigned long)intvl);
+        }
+        return p - row;
+    }
+    if (exportstage == 1) {
+        p += sprintf(p, "index,dt_us");
+        for (uint8_t s = 0; s < series; s++) {
+            p += envelope ? sprintf(p, ",lo%u,hi%u", s, s) : sprintf(p, ",s%u", s);
+        }
+        *p++ = '\n';
+        return p - row;
+    }
+    if (!exportpos) {
+        if ((int32_t)(exportlast - exportnext) >= 0 && colserial - exportnext >= count) {
+            exportnext = colserial - count + 1;
+        }
+        if ((int32_t)(exportlast - exportnext) < 0) {
+            return 0;
+        }
+        uint16_t slot = (ndx + grwidth - (colserial - exportnext)) % grwidth;
+        exportdt = decodeStamp(stamp[slot]);
+        for (uint8_t s = 0; s < series; s++) {
+            exportcol[2 * s] = datalow[s * grwidth + slot];
+            exportcol[2 * s + 1] = dataset[s * grwidth + slot];
+        }
+    }
+    uint16_t index = exportnext - exportfirst;
+    if (binary) {
+        p = exportWord(p, index, 2);
+        p = exportWord(p, exportdt, 4);
+        for (uint8_t s = 0; s < series; s++) {
+            if (envelope) {
+                memcpy(p, &exportcol[2 * s], sizeof(SampleT));
+                p += sizeof(SampleT);
+            }
+            memcpy(p, &exportcol[2 * s + 1], sizeof(SampleT));
+            p += sizeof(SampleT);
+        }
+        return p - row;
+    }
+    p += sprintf(p, "%u,%lu", index, (unsigned long)exportdt);
+    for (uint8_t s = 0; s < series; s++) {
+        if (envelope) {
+            p = exportValue(p, exportcol[2 * s]);
+        }
+        p = exportValue(p, exportcol[2 * s + 1]);
+    }
+    *p++ = '\n';
+    return p - row;
+}
+
+//Append one CSV value, floats with 3 decimals at most, returns the end of the text.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+char *U8g2GraphingT<SampleT, Capacity>::exportValue(char *p, SampleT var) {
+    *p++ = ',';
+    if (!Traits::isInteger && !isTypeInt) {
+        formatFloat(p, var, 3);
+        p += strlen(p);
+        if (p[-1] >= '0' && p[-1] <= '9') {
+            while (p[-1] == '0') {
+                p--;
+            }
+            if (p[-1] == '.') {
+                p--;
+            }
+        }
+        return p;
+    }
+    if (var < 0) {
+        return p + sprintf(p, "%ld", (long)var);
+    }
+    return p + sprintf(p, "%lu", (unsigned long)var);
+}
+
+//Append an integer of the given bytes, little endian.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+char *U8g2GraphingT<SampleT, Capacity>::exportWord(char *p, uint32_t value, uint8_t bytes) {
+    for (uint8_t b = 0; b < bytes; b++) {
+        *p++ = (char)(value >> (8 * b));
+    }
+    return p;
+}
+
+//Return the peak to peak value of the first series over the filled columns,
+//the same window as getMean() and getStdDev(), decimated columns by their envelope.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+float U8g2GraphingT<SampleT, Capacity>::getPeakToPeak() {
+    typedef typename Traits::wide_t wide_t;
+    if (!statn) {
+        return 0;
+    }
+    SampleT lo = datalow[ndx];
+    SampleT hi = dataset[ndx];
+    uint16_t i = ndx;
+    for (uint16_t n = 1; n < statn; n++) {
+        i = (i == 0) ? grwidth - 1 : i - 1;
+        lo = (datalow[i] < lo) ? datalow[i] : lo;
+        hi = (dataset[i] > hi) ? dataset[i] : hi;
+    }
+    return Traits::isInteger ? (float)((wide_t)hi - (wide_t)lo) : (float)hi - (float)lo;
+}
+
+//Return the instrumentation counters, all zero but the reprojections
+//unless U8G2GRAPH_STATS is set.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+U8g2GraphingStats U8g2GraphingT<SampleT, Capacity>::getStats() {
+#if U8G2GRAPH_STATS
+    U8g2GraphingStats s = stats;
+#else
+    U8g2GraphingStats s = {};
+#endif
+    s.reprojections = reprojcount;
+    return s;
+}
+
+//Clear the instrumentation counters.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::clearStats() {
+#if U8G2GRAPH_STATS
+    stats = U8g2GraphingStats();
+    renderus = 0;
+    framed = false;
+#endif
+    reprojcount = 0;
+}
+
+//Print the instrumentation counters, one line per stage with the
+//average, min and max µs, then the rejected samples.
+//========================================================================
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::printStats(Stream &out) {
+    U8g2GraphingStats s = getStats();
+    printStage(out, "input", s.input);
+    printStage(out, "render", s.render);
+    printStage(out, "frame", s.frame);
+    out.print("gated ");
+    out.print(s.gated);
+    out.print(" stopped ");
+    out.print(s.stopped);
+    out.print(" dropped ");
+    out.print(s.dropped);
+    out.print(" reproj ");
+    out.println(s.reprojections);
+}
+
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::printStage(Stream &out, const char *name, const U8g2GraphingStage &stage) {
+    out.print(name);
+    out.print(" calls ");
+    out.print(stage.calls);
+    out.print(" avg ");
+    out.print(stage.calls ? stage.total / stage.calls : 0);
+    out.print(" min ");
+    out.print(stage.min);
+    out.print(" max ");
+    out.print(stage.max);
+    out.println(" us");
+}
+
+#if U8G2GRAPH_STATS
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::statStage(U8g2GraphingStage &stage, uint32_t us) {
+    if (!stage.calls || us < stage.min) {
+        stage.min = us;
+    }
+    if (us > stage.max) {
+        stage.max = us;
+    }
+    stage.total += us;
+    stage.calls++;
+}
+
+//Count samples rejected by the interval gate or while stopped.
+template <typename SampleT, uint16_t Capacity>
+void U8g2GraphingT<SampleT, Capacity>::statRejected(size_t n) {
+    if (!activate) {
+        stats.stopped += n;
+    } else {
+        stats.gated += n;
+    }
+}
+#endif
+
 #endif
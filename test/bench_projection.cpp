@@ -0,0 +1,53 @@
+//Host benchmark of the per-column projection, float against fixed-point.
+//Input reprojects every column once the range moved, so the range alternates
+//on every sample, the time of a sample with a steady range is subtracted and
+//the rest divided by the columns reprojected, counted by getReprojectCount().
+#include "test.h"
+#include <chrono>
+
+static U8G2 display(128, 64, 8);
+
+static double nowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//Best of several runs, ns per sample.
+template <typename T> double sampleTime(U8g2GraphingT<T> &graph, bool alternate, int samples) {
+    double best = 0;
+    for (int run = 0; run < 7; run++) {
+        double start = nowNs();
+        for (int i = 0; i < samples; i++) {
+            graph.rangeSet(true, (alternate && (i & 1)) ? -110 : -100, 100);
+            T row[2] = {(T)(i % 180 - 90), (T)(90 - i % 180)};
+            graph.inputSeries(row);
+        }
+        double t = (nowNs() - start) / samples;
+        best = (run == 0 || t < best) ? t : best;
+    }
+    return best;
+}
+
+template <typename T> void columnTime(const char *name, bool fixedpoint) {
+    const int samples = 20000;
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, 127, 63);
+    graph.seriesSet(2);
+    graph.projectionSet(fixedpoint);
+    double steady = sampleTime(graph, false, samples);
+    uint32_t before = graph.getReprojectCount();
+    double moving = sampleTime(graph, true, samples);
+    double perSample = (double)(graph.getReprojectCount() - before) / (7.0 * samples);
+    double ns = (moving - steady) / (perSample * graph.getDataLen() * 2);
+    printf("%-6s %-5s steady %7.1f ns/sample  reprojected %8.1f ns/sample  %6.2f ns/column\n", name,
+           fixedpoint ? "fixed" : "float", steady, moving, ns);
+}
+
+int main() {
+    columnTime<int16_t>("int16", false);
+    columnTime<int16_t>("int16", true);
+    columnTime<int32_t>("int32", false);
+    columnTime<int32_t>("int32", true);
+    columnTime<float>("float", false);
+    columnTime<float>("float", true);
+    return 0;
+}
@@ -0,0 +1,56 @@
+//Host benchmark of the input and render paths, ns per sample and per frame
+//for several sample types and graph widths, on a full and a page buffer display.
+//The shim clock advances 1ms per sample so every run draws the same frames.
+#include "test.h"
+#include <chrono>
+
+static U8G2 fullDisplay(128, 64, 8);
+static U8G2 pageDisplay(128, 64, 1);
+
+static double nowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T> void runCase(const char *name, uint16_t tox) {
+    const int samples = 20000;
+    const int frames = 500;
+    U8g2GraphingT<T> full(&fullDisplay), page(&pageDisplay);
+    full.begin(0, 9, tox, 63);
+    page.begin(0, 9, tox, 63);
+
+    double start = nowNs();
+    for (int i = 0; i < samples; i++) {
+        g_micros += 1000;
+        g_millis = g_micros / 1000;
+        full.inputValue((float)(sin(i * 0.07) * 100 + ((i % 37 == 0) ? 40 : 0) + 105));
+    }
+    double input = (nowNs() - start) / samples;
+
+    double fullTime = 0;
+    double pageTime = 0;
+    for (int f = 0; f < frames; f++) {
+        g_micros += 1000;
+        g_millis = g_micros / 1000;
+        float v = sin(f * 0.07) * 100 + 105;
+        full.inputValue(v);
+        page.inputValue(v);
+        start = nowNs();
+        fullDisplay.clearBuffer();
+        full.displayGraph();
+        fullTime += nowNs() - start;
+        start = nowNs();
+        renderFrame(pageDisplay, page);
+        pageTime += nowNs() - start;
+    }
+    printf("%-7s w%-4u input %8.1f ns/sample  full %9.1f ns/frame  page %9.1f ns/frame\n", name, full.getDataLen() + 2,
+           input, fullTime / frames, pageTime / frames);
+}
+
+int main() {
+    for (uint16_t tox = 60; tox <= 127; tox += 67) {
+        runCase<int16_t>("int16", tox);
+        runCase<uint8_t>("uint8", tox);
+        runCase<float>("float", tox);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+//Minimal Arduino core for building the library on the host.
+//millis() and micros() read a clock the tests advance by hand.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+#define PI 3.14159265358979
+#define DEC 10
+#define HEX 16
+
+extern uint32_t g_millis, g_micros;
+inline uint32_t millis() { return g_millis; }
+inline uint32_t micros() { return g_micros; }
+inline void delay(unsigned long) {}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define noInterrupts() do {} while (0)
+#define interrupts() do {} while (0)
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define INPUT 0
+inline void pinMode(int, int) {}
+inline int analogRead(int) { return 512; }
+
+//Print with the number formatting of the AVR core.
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *b, size_t n) {
+        size_t r = 0;
+        while (n--) {
+            r += write(*b++);
+        }
+        return r;
+    }
+    //Same default as the Arduino core, streams that know their room override it.
+    virtual int availableForWrite() { return 0; }
+    size_t print(const char *s) {
+        size_t n = 0;
+        while (*s) {
+            n += write((uint8_t)*s++);
+        }
+        return n;
+    }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned int v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(unsigned int v, int base) { return printf(base == HEX ? "%X" : "%u", v); }
+    size_t print(unsigned long v, int base) { return printf(base == HEX ? "%lX" : "%lu", v); }
+    size_t print(double number, int digits = 2) {
+        size_t n = 0;
+        if (isnan(number)) return print("nan");
+        if (isinf(number)) return print("inf");
+        if (number > 4294967040.0 || number < -4294967040.0) return print("ovf");
+        if (number < 0.0) {
+            n += print('-');
+            number = -number;
+        }
+        double rounding = 0.5;
+        for (uint8_t i = 0; i < digits; ++i) {
+            rounding /= 10.0;
+        }
+        number += rounding;
+        unsigned long intpart = (unsigned long)number;
+        double remainder = number - (double)intpart;
+        n += print(intpart);
+        if (digits > 0) {
+            n += print('.');
+        }
+        while (digits-- > 0) {
+            remainder *= 10.0;
+            unsigned int digit = (unsigned int)remainder;
+            n += print(digit);
+            remainder -= digit;
+        }
+        return n;
+    }
+    size_t println(const char *s = "") { return print(s) + print("\r\n"); }
+    template <typename T> size_t println(T v) { return print(v) + print("\r\n"); }
+    template <typename T> size_t println(T v, int d) { return print(v, d) + print("\r\n"); }
+
+private:
+    template <typename T> size_t printf(const char *fmt, T v) {
+        char b[24];
+        snprintf(b, sizeof(b), fmt, v);
+        return print(b);
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+};
+
+//Serial writes to stdout and always has room.
+struct HardwareSerial : public Stream {
+    size_t write(uint8_t c) override { return fputc(c, stdout) != EOF; }
+    int availableForWrite() override { return 64; }
+    void begin(long) {}
+};
+extern HardwareSerial Serial;
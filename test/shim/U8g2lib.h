@@ -0,0 +1,261 @@
+//Mock of the U8g2 C++ API used by the library: a monochrome display with the
+//vertical byte layout of the SSD1306, full or page buffer. frame holds the
+//composed picture as one byte per pixel once the last page is done.
+#pragma once
+#include <Arduino.h>
+#include <vector>
+
+#ifdef U8G2_16BIT
+typedef uint16_t u8g2_uint_t;
+#else
+typedef uint8_t u8g2_uint_t;
+#endif
+
+struct u8g2_struct;
+typedef struct u8g2_struct u8g2_t;
+typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, uint16_t x, uint16_t y, uint16_t len, uint8_t dir);
+struct u8g2_cb_struct {
+    int rotation;
+};
+typedef struct u8g2_cb_struct u8g2_cb_t;
+extern const u8g2_cb_t u8g2_cb_r0, u8g2_cb_r2;
+#define U8G2_R0 (&u8g2_cb_r0)
+#define U8G2_R2 (&u8g2_cb_r2)
+#define U8X8_PIN_NONE 255
+void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, uint16_t x, uint16_t y, uint16_t len, uint8_t dir);
+void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, uint16_t x, uint16_t y, uint16_t len, uint8_t dir);
+struct u8g2_struct {
+    const u8g2_cb_t *cb;
+    u8g2_draw_ll_hvline_cb ll_hvline;
+    u8g2_uint_t user_x0, user_x1, user_y0, user_y1;
+};
+extern const uint8_t u8g2_font_tom_thumb_4x6_tn[], u8g2_font_tom_thumb_4x6_tf[], u8g2_font_6x10_tr[];
+
+class U8G2 : public Print {
+public:
+    U8G2(int w = 128, int h = 64, int pageRows = 8, const u8g2_cb_t *rot = U8G2_R0) : w(w), h(h), pageRows(pageRows) {
+        st.cb = rot;
+        st.ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+        buf.assign(w * pageRows, 0);
+        frame.assign(w * h, 0);
+        window();
+    }
+
+    int w, h, pageRows;
+    int currRow = 0;
+    std::vector<uint8_t> buf;
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> panel;
+    u8g2_t st;
+    int color = 1;
+    int cx = 0, cy = 0;
+    int clx0 = 0, cly0 = 0, clx1 = 1 << 15, cly1 = 1 << 15;
+    long ops = 0, areaUpdates = 0, areaTiles = 0;
+
+    void begin() {}
+    u8g2_t *getU8g2() { return &st; }
+    uint8_t *getBufferPtr() { return buf.data(); }
+    uint8_t getBufferTileHeight() { return pageRows; }
+    uint8_t getBufferTileWidth() { return w / 8; }
+    uint8_t getBufferCurrTileRow() { return currRow; }
+    void setBufferCurrTileRow(uint8_t row) {
+        currRow = row;
+        window();
+    }
+    uint16_t getDisplayWidth() { return w; }
+    uint16_t getDisplayHeight() { return h; }
+    void setBusClock(uint32_t) {}
+
+    void clearBuffer() { std::fill(buf.begin(), buf.end(), 0); }
+    void sendBuffer() { compose(); }
+    void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+        areaUpdates++;
+        areaTiles += tw * th;
+        if (panel.size() != buf.size()) {
+            panel.assign(buf.size(), 0);
+        }
+        for (int r = ty; r < ty + th; r++) {
+            for (int c = tx * 8; c < (tx + tw) * 8; c++) {
+                panel[r * w + c] = buf[r * w + c];
+            }
+        }
+        compose();
+    }
+    void firstPage() {
+        currRow = 0;
+        window();
+        clearBuffer();
+    }
+    uint8_t nextPage() {
+        compose();
+        currRow += pageRows;
+        if (currRow * 8 >= h) {
+            currRow = 0;
+            window();
+            return 0;
+        }
+        window();
+        clearBuffer();
+        return 1;
+    }
+
+    void setDrawColor(int c) { color = c; }
+    void setFont(const uint8_t *) {}
+    void setFontMode(int) {}
+    void setClipWindow(int x0, int y0, int x1, int y1) {
+        clx0 = x0;
+        cly0 = y0;
+        clx1 = x1;
+        cly1 = y1;
+    }
+    void setMaxClipWindow() {
+        clx0 = 0;
+        cly0 = 0;
+        clx1 = 1 << 15;
+        cly1 = 1 << 15;
+    }
+    void drawPixel(int x, int y) {
+        ops++;
+        pixel(x, y);
+    }
+    void drawHLine(int x, int y, int len) {
+        ops++;
+        for (int i = 0; i < (len & 0xffff); i++) {
+            pixel(x + i, y);
+        }
+    }
+    void drawVLine(int x, int y, int len) {
+        ops++;
+        for (int i = 0; i < (len & 0xffff); i++) {
+            pixel(x, y + i);
+        }
+    }
+    void drawBox(int x, int y, int bw, int bh) {
+        ops++;
+        for (int j = 0; j < (bh & 0xffff); j++) {
+            for (int i = 0; i < (bw & 0xffff); i++) {
+                pixel(x + i, y + j);
+            }
+        }
+    }
+    void drawFrame(int x, int y, int fw, int fh) {
+        drawHLine(x, y, fw);
+        drawHLine(x, y + fh - 1, fw);
+        drawVLine(x, y, fh);
+        drawVLine(x + fw - 1, y, fh);
+    }
+    //Bresenham as in u8g2_DrawLine().
+    void drawLine(int x1, int y1, int x2, int y2) {
+        ops++;
+        x1 &= 0xffff;
+        y1 &= 0xffff;
+        x2 &= 0xffff;
+        y2 &= 0xffff;
+        int tmp, swapxy = 0;
+        int dx = x1 > x2 ? x1 - x2 : x2 - x1;
+        int dy = y1 > y2 ? y1 - y2 : y2 - y1;
+        if (dy > dx) {
+            swapxy = 1;
+            tmp = dx; dx = dy; dy = tmp;
+            tmp = x1; x1 = y1; y1 = tmp;
+            tmp = x2; x2 = y2; y2 = tmp;
+        }
+        if (x1 > x2) {
+            tmp = x1; x1 = x2; x2 = tmp;
+            tmp = y1; y1 = y2; y2 = tmp;
+        }
+        int err = dx >> 1;
+        int ystep = (y2 > y1) ? 1 : -1;
+        int y = y1;
+        for (int x = x1; x <= x2; x++) {
+            if (swapxy) {
+                pixel(y, x);
+            } else {
+                pixel(x, y);
+            }
+            err -= dy;
+            if (err < 0) {
+                y += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    //Text is drawn as a 3x5 pattern derived from the character code,
+    //enough to catch a moved or changed label.
+    void setCursor(int x, int y) {
+        cx = x;
+        cy = y;
+    }
+    size_t write(uint8_t c) override {
+        for (int r = 0; r < 5; r++) {
+            for (int k = 0; k < 3; k++) {
+                if (((c * 2654435761u) >> (r * 3 + k)) & 1) {
+                    pixel(cx + k, cy - 5 + r);
+                }
+            }
+        }
+        cx += 4;
+        return 1;
+    }
+    int getStrWidth(const char *s) { return (int)strlen(s) * 4; }
+    void drawStr(int x, int y, const char *s) {
+        setCursor(x, y);
+        print(s);
+    }
+    uint8_t getAscent() { return 5; }
+
+    void dump(FILE *f) {
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                fputc(frame[y * w + x] ? '#' : '.', f);
+            }
+            fputc('\n', f);
+        }
+    }
+
+private:
+    void window() {
+        st.user_x0 = 0;
+        st.user_x1 = w;
+        st.user_y0 = currRow * 8;
+        st.user_y1 = ((currRow + pageRows) * 8 > h) ? h : (currRow + pageRows) * 8;
+    }
+    void pixel(int x, int y) {
+        x &= 0xffff;
+        y &= 0xffff;
+        if (x < clx0 || x >= clx1 || y < cly0 || y >= cly1 || x >= w || y >= h) {
+            return;
+        }
+        int yy = y - currRow * 8;
+        if (yy < 0 || yy >= pageRows * 8) {
+            return;
+        }
+        uint8_t &b = buf[(yy >> 3) * w + x];
+        uint8_t m = 1 << (yy & 7);
+        if (color == 1) {
+            b |= m;
+        } else if (color == 0) {
+            b &= ~m;
+        } else {
+            b ^= m;
+        }
+    }
+    void compose() {
+        for (int y = currRow * 8; y < (currRow + pageRows) * 8 && y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int yy = y - currRow * 8;
+                frame[y * w + x] = (buf[(yy >> 3) * w + x] >> (yy & 7)) & 1;
+            }
+        }
+    }
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_HW_I2C : public U8G2 {
+public:
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C(const u8g2_cb_t *r, int) : U8G2(128, 64, 1, r) {}
+};
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2 {
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t *r, int) : U8G2(128, 64, 8, r) {}
+};
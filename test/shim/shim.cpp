@@ -0,0 +1,13 @@
+#include <U8g2lib.h>
+
+uint32_t g_millis = 0;
+uint32_t g_micros = 0;
+HardwareSerial Serial;
+
+const u8g2_cb_t u8g2_cb_r0 = {0};
+const u8g2_cb_t u8g2_cb_r2 = {2};
+void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *, uint16_t, uint16_t, uint16_t, uint8_t) {}
+void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *, uint16_t, uint16_t, uint16_t, uint8_t) {}
+const uint8_t u8g2_font_tom_thumb_4x6_tn[1] = {0};
+const uint8_t u8g2_font_tom_thumb_4x6_tf[1] = {0};
+const uint8_t u8g2_font_6x10_tr[1] = {0};
@@ -0,0 +1,129 @@
+//Checks and frame helpers shared by the host tests. A test returns the number
+//of failed checks from main(), so ctest reports it as failed.
+#pragma once
+#include <U8g2Graphing.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                      \
+    do {                                                                 \
+        if (!(cond)) {                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                  \
+        }                                                                \
+    } while (0)
+
+#define CHECK_MSG(cond, ...)                                             \
+    do {                                                                 \
+        if (!(cond)) {                                                   \
+            printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                         \
+            printf("\n");                                                \
+            failures++;                                                  \
+        }                                                                \
+    } while (0)
+
+static inline int testResult(const char *name) {
+    printf("%s: %s\n", name, failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
+
+//Draw a whole frame, page by page on a page buffer display.
+template <typename G> void renderFrame(U8G2 &display, G &graph) {
+    display.firstPage();
+    do {
+        graph.displayGraph();
+    } while (display.nextPage());
+}
+
+//The composed frame as text, one line of '#' and '.' per row.
+static inline std::string frameText(U8G2 &display) {
+    std::string s;
+    for (int y = 0; y < display.h; y++) {
+        for (int x = 0; x < display.w; x++) {
+            s += display.frame[y * display.w + x] ? '#' : '.';
+        }
+        s += '\n';
+    }
+    return s;
+}
+
+static inline uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+//Compare text with a file of test/golden, U8G2GRAPH_UPDATE_GOLDEN=1 rewrites the file.
+static inline bool matchGolden(const char *name, const std::string &actual) {
+    std::string path = std::string(GOLDEN_DIR) + "/" + name;
+    if (getenv("U8G2GRAPH_UPDATE_GOLDEN")) {
+        FILE *f = fopen(path.c_str(), "wb");
+        fwrite(actual.data(), 1, actual.size(), f);
+        fclose(f);
+        return true;
+    }
+    std::string expected;
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) {
+        printf("missing golden file %s\n", path.c_str());
+        return false;
+    }
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        expected.append(chunk, n);
+    }
+    fclose(f);
+    if (expected == actual) {
+        return true;
+    }
+    size_t line = 1;
+    for (size_t i = 0; i < expected.size() && i < actual.size() && expected[i] == actual[i]; i++) {
+        line += (expected[i] == '\n');
+    }
+    printf("%s differs from the golden file at line %u\n", name, (unsigned)line);
+    return false;
+}
+
+//Stream keeping everything written to it.
+struct TextSink : Stream {
+    std::string text;
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1;
+    }
+};
+
+//The shown columns, oldest first, as the low and high value of the first series
+//read back through a CSV export. A column without envelope has low == high.
+template <typename G> std::vector<std::pair<long long, long long>> shownColumns(G &graph) {
+    TextSink sink;
+    graph.exportStart(U8G2GRAPH_EXPORT_CSV);
+    while (graph.exportData(sink, 256)) {
+    }
+    std::vector<std::pair<long long, long long>> columns;
+    bool envelope = sink.text.find(",lo0") != std::string::npos;
+    size_t pos = sink.text.find('\n', sink.text.find("index,")) + 1;
+    while (pos < sink.text.size()) {
+        const char *p = sink.text.c_str() + pos;
+        p = strchr(strchr(p, ',') + 1, ',') + 1;
+        char *end;
+        long long lo = strtoll(p, &end, 10);
+        long long hi = envelope ? strtoll(end + 1, nullptr, 10) : lo;
+        columns.push_back(std::make_pair(lo, hi));
+        pos = sink.text.find('\n', pos) + 1;
+    }
+    return columns;
+}
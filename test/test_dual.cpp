@@ -0,0 +1,47 @@
+//A producer thread feeding pushFromISR() while the main thread draws, as a task
+//on the other core of an ESP32 would. The input is a ramp, so a frame drawn from
+//a consistent window spans exactly one step per column.
+#include "test.h"
+#include <atomic>
+#include <thread>
+
+static U8G2 display(128, 64, 8);
+static U8g2GraphingT<int32_t> graph(&display);
+static std::atomic<bool> done(false);
+static std::atomic<long> produced(0);
+
+static void producer() {
+    int32_t v = 0;
+    uint32_t t = 0;
+    while (!done) {
+        t += 100;
+        if (graph.pushFromISR(v, t)) {
+            v++;
+            produced++;
+        }
+    }
+}
+
+int main() {
+    graph.begin(0, 9, 127, 63);
+    graph.queueSet(4096);
+    std::thread thread(producer);
+    while (produced < 1000) {
+        std::this_thread::yield();
+    }
+    for (int f = 0; f < 1500; f++) {
+        display.clearBuffer();
+        graph.displayGraph();
+        long span = (long)(graph.getDataMax() - graph.getDataMin());
+        if (span != graph.getDataLen() + 1) {
+            CHECK_MSG(false, "frame %d: %g to %g over %u columns", f, graph.getDataMin(), graph.getDataMax(),
+                      graph.getDataLen());
+            break;
+        }
+    }
+    done = true;
+    thread.join();
+    graph.update();
+    CHECK_MSG(graph.getDataMax() == (float)(produced - 1), "last sample %g, produced %ld", graph.getDataMax(), produced.load());
+    return testResult("dual");
+}
@@ -0,0 +1,126 @@
+//exportData() over streams with and without an availableForWrite() budget,
+//rows split over several calls and a graph moving while it is exported.
+#include "test.h"
+
+//Stream collecting the export, room is what availableForWrite() reports.
+struct Sink : Stream {
+    std::string text;
+    int room = 0;
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1;
+    }
+    int availableForWrite() override { return room; }
+};
+
+static U8G2 display(128, 64, 8);
+
+static void tick() {
+    g_micros += 1000;
+    g_millis = g_micros / 1000;
+}
+
+//Call exportData() until it is done, returns the number of calls.
+template <typename G> int drain(G &graph, Sink &sink, size_t maxBytes) {
+    int calls = 1;
+    while (graph.exportData(sink, maxBytes) != U8G2GRAPH_EXPORT_DONE && calls < 10000) {
+        calls++;
+    }
+    return calls;
+}
+
+//The whole export in one call.
+template <typename G> std::string reference(G &graph, U8g2GraphingExport format) {
+    Sink sink;
+    graph.exportStart(format);
+    CHECK(graph.exportData(sink, 100000) == U8G2GRAPH_EXPORT_DONE);
+    return sink.text;
+}
+
+int main() {
+    U8g2GraphingT<int16_t> graph(&display);
+    graph.begin(0, 0, 40, 63);
+    graph.intervalSet(1);
+    for (int i = 0; i < 25; i++) {
+        tick();
+        graph.inputValue(i * 3 - 20);
+    }
+    std::string csv = reference(graph, U8G2GRAPH_EXPORT_CSV);
+    CHECK(csv.compare(0, 63, "#columns=20,series=1,decimation=1,interval_ms=1\nindex,dt_us,s0\n") == 0);
+    CHECK(csv.size() > 11 && csv.compare(csv.size() - 11, 11, "19,1000,52\n") == 0);
+
+    //No budget and no maxBytes, as the Print default, SoftwareSerial or a File:
+    //the export waits and nothing is written.
+    Sink none;
+    graph.exportStart(U8G2GRAPH_EXPORT_CSV);
+    for (int i = 0; i < 5; i++) {
+        CHECK(graph.exportData(none) == U8G2GRAPH_EXPORT_WAITING);
+    }
+    CHECK(none.text.empty());
+
+    //The same stream with maxBytes shorter than the header line.
+    CHECK(drain(graph, none, 40) > 1);
+    CHECK(none.text == csv);
+
+    //A serial port whose buffer is full for a while, the export waits for it.
+    Sink serial;
+    graph.exportStart(U8G2GRAPH_EXPORT_CSV);
+    CHECK(graph.exportData(serial) == U8G2GRAPH_EXPORT_WAITING);
+    CHECK(graph.exportData(serial) == U8G2GRAPH_EXPORT_WAITING);
+    serial.room = 64;
+    CHECK(drain(graph, serial, 0) > 1);
+    CHECK(serial.text == csv);
+
+    //Binary records a few bytes at a time.
+    std::string bin = reference(graph, U8G2GRAPH_EXPORT_BINARY);
+    Sink bytes;
+    graph.exportStart(U8G2GRAPH_EXPORT_BINARY);
+    CHECK(drain(graph, bytes, 5) > 1);
+    CHECK(bytes.text == bin);
+
+    //Rows of 4 decimated float series are longer than the 63 bytes an AVR
+    //serial port reports, they are split instead of stalling the export.
+    U8g2GraphingT<float> wide(&display);
+    wide.begin(0, 0, 60, 63);
+    wide.seriesSet(4);
+    wide.decimationSet(3);
+    for (int i = 0; i < 200; i++) {
+        tick();
+        float row[4] = {-12345.678f + i, 23456.125f - i, -3456.5f * i, 0.001f * i};
+        wide.inputSeries(row);
+    }
+    std::string rows = reference(wide, U8G2GRAPH_EXPORT_CSV);
+    size_t longest = 0;
+    for (size_t at = 0, end; (end = rows.find('\n', at)) != std::string::npos; at = end + 1) {
+        longest = (end - at > longest) ? end - at : longest;
+    }
+    CHECK_MSG(longest > 63, "longest row %u bytes", (unsigned)longest);
+    Sink avr;
+    avr.room = 63;
+    wide.exportStart(U8G2GRAPH_EXPORT_CSV);
+    CHECK(drain(wide, avr, 0) < 10000);
+    CHECK(avr.text == rows);
+
+    //A graph moving while it is exported a few bytes at a time: every row
+    //still has all its fields, split rows are sent from the copy of their column.
+    Sink moving;
+    wide.exportStart(U8G2GRAPH_EXPORT_CSV);
+    int calls = 0;
+    while (wide.exportData(moving, 7) != U8G2GRAPH_EXPORT_DONE && calls++ < 10000) {
+        tick();
+        float row[4] = {1.5f * calls, -2.25f * calls, 3.0f, 4.0f};
+        wide.inputSeries(row);
+    }
+    int lines = 0;
+    for (size_t at = moving.text.find("index"), end; (end = moving.text.find('\n', at)) != std::string::npos; at = end + 1) {
+        std::string line = moving.text.substr(at, end - at);
+        int commas = 0;
+        for (char c : line) {
+            commas += (c == ',');
+        }
+        CHECK_MSG(commas == 9, "row \"%s\"", line.c_str());
+        lines++;
+    }
+    CHECK(lines > 10);
+    return testResult("export");
+}
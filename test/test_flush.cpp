@@ -0,0 +1,114 @@
+//Tile state of flush(): partial transfers from a caller buffer or the heap,
+//and no allocation by begin() or flush() once the tile state has its room.
+#include "test.h"
+#include <new>
+
+static long allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    free(p);
+}
+
+static U8G2 display(128, 64, 8);
+
+//Draw a frame, after a sample unless value is negative, and flush it.
+//A partial transfer has to leave the panel equal to the buffer.
+//Returns the tiles sent.
+template <typename G> uint16_t frame(G &graph, int value) {
+    if (value >= 0) {
+        graph.inputValue(value);
+    }
+    display.clearBuffer();
+    graph.displayGraph();
+    uint16_t sent = graph.flush();
+    if (sent < 128) {
+        CHECK(display.panel == display.buf);
+    }
+    return sent;
+}
+
+int main() {
+    //The mock panel is sized on its first update, the tests clear it
+    //on a new layout as a sketch would clear the screen.
+    display.updateDisplayArea(0, 0, 16, 8);
+
+    //Static storage and a caller tile buffer never allocate, a steady frame sends nothing.
+    static uint32_t tiles[U8g2GraphingBase::flushBytes(128, 64) / sizeof(uint32_t)];
+    U8g2GraphingT<int16_t, 108> fixed(&display);
+    fixed.flushBufferSet(tiles, sizeof(tiles));
+    long before = allocations;
+    for (int round = 0; round < 3; round++) {
+        fixed.begin(0, 0, 127, 63);
+        CHECK(frame(fixed, 5) == 128);
+        CHECK(frame(fixed, -1) == 0);
+        CHECK(frame(fixed, -1) == 0);
+        CHECK(frame(fixed, 40) > 0);
+    }
+    fixed.begin(10, 20, 80, 50);
+    std::fill(display.panel.begin(), display.panel.end(), 0);
+    CHECK(frame(fixed, 5) == 10 * 5);
+    CHECK_MSG(allocations == before, "%ld allocations", allocations - before);
+
+    //Without a tile buffer such a graph sends the whole buffer.
+    fixed.flushBufferSet(nullptr, 0);
+    before = allocations;
+    CHECK(frame(fixed, 5) == 128);
+    CHECK(frame(fixed, 5) == 128);
+    CHECK(allocations == before);
+
+    //A tile buffer too small for the graph does the same.
+    fixed.flushBufferSet(tiles, 16);
+    CHECK(frame(fixed, 5) == 128);
+
+    //So does a graph on a bufferSet() buffer.
+    static int16_t storage[U8g2GraphingT<int16_t>::bytesNeeded(108) / sizeof(int16_t)];
+    U8g2GraphingT<int16_t> user(&display);
+    user.bufferSet(storage, sizeof(storage));
+    before = allocations;
+    user.begin(0, 0, 127, 63);
+    CHECK(frame(user, 5) == 128);
+    CHECK(frame(user, -1) == 128);
+    CHECK(allocations == before);
+
+    //The heap graph allocates its tile state once and keeps it over begin().
+    U8g2GraphingT<int16_t> heap(&display);
+    heap.begin(0, 0, 127, 63);
+    before = allocations;
+    CHECK(frame(heap, 5) == 128);
+    CHECK(allocations == before + 1);
+    for (int round = 0; round < 3; round++) {
+        heap.begin(0, 0, 127, 63);
+        CHECK(frame(heap, 5) == 128);
+        CHECK(frame(heap, -1) == 0);
+    }
+    heap.begin(10, 20, 80, 50);
+    std::fill(display.panel.begin(), display.panel.end(), 0);
+    CHECK(frame(heap, 5) == 10 * 5);
+    CHECK(allocations == before + 1);
+    return testResult("flush");
+}
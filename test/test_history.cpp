@@ -0,0 +1,113 @@
+//History views against a scan of the samples, at several offsets and zooms,
+//while the ring fills and after it wrapped, and setView(x, 0) back to the live
+//columns of a graph without history fed the same samples.
+#include "test.h"
+
+static U8G2 display(128, 64, 8);
+
+template <typename T>
+bool checkView(const char *name, U8g2GraphingT<T> &graph, const std::vector<T> &all, uint32_t size, uint32_t offset,
+               uint16_t spc) {
+    uint32_t total = all.size();
+    uint32_t oldest = (total > size) ? total - size : 0;
+    uint32_t end = total - ((offset < total) ? offset : total);
+    uint32_t first = (offset == 0 && end % spc) ? end % spc : spc;
+    uint16_t n = 0;
+    while (n < 107 && end >= oldest + first + (uint32_t)n * spc) {
+        n++;
+    }
+    graph.setView(offset, spc);
+    std::vector<std::pair<long long, long long>> got = shownColumns(graph);
+    if (got.size() != n) {
+        CHECK_MSG(false, "%s sample %u offset %u zoom %u: %u columns, expected %u", name, total, offset, spc,
+                  (unsigned)got.size(), n);
+        return false;
+    }
+    for (uint16_t c = 0; c < n; c++) {
+        uint16_t back = n - 1 - c;
+        uint32_t from = end - first - (uint32_t)back * spc;
+        uint32_t to = from + (back ? spc : first);
+        long long lo = (long long)all[from];
+        long long hi = lo;
+        for (uint32_t t = from; t < to; t++) {
+            lo = ((long long)all[t] < lo) ? (long long)all[t] : lo;
+            hi = ((long long)all[t] > hi) ? (long long)all[t] : hi;
+        }
+        if (got[c].first != lo || got[c].second != hi) {
+            CHECK_MSG(false, "%s sample %u offset %u zoom %u samples %u..%u: %lld %lld, scan %lld %lld", name, total,
+                      offset, spc, from, to, got[c].first, got[c].second, lo, hi);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T> void run(const char *name, uint16_t decim, int base, int spread, bool callerBuffer) {
+    U8g2GraphingT<T> graph(&display);
+    U8g2GraphingT<T> live(&display);
+    graph.begin(0, 0, 127, 63);
+    live.begin(0, 0, 127, 63);
+    graph.decimationSet(decim);
+    live.decimationSet(decim);
+    static uint32_t buffer[4096];
+    if (callerBuffer) {
+        graph.historySet(buffer, U8g2GraphingT<T>::historyBytes(1024) + 5);
+    } else {
+        graph.historySet(1500);
+    }
+    std::vector<T> all;
+    int v = base;
+    for (int i = 0; i < 3000; i++) {
+        v += rand() % 9 - 4;
+        if (rand() % 50 == 0) {
+            v = base + rand() % spread;
+        }
+        v = (v < base) ? base : (v >= base + spread) ? base + spread - 1 : v;
+        all.push_back((T)v);
+        g_micros += 1000;
+        g_millis = g_micros / 1000;
+        graph.inputValue((T)v);
+        live.inputValue((T)v);
+        if (graph.getHistoryLen() != ((all.size() < 1024) ? all.size() : 1024)) {
+            CHECK_MSG(false, "%s sample %d: history of %u", name, i, graph.getHistoryLen());
+            return;
+        }
+
+        //A view kept while samples come in, then back to live.
+        if (i % 397 == 0) {
+            graph.setView(i % 3 ? 50 : 0, 4);
+        } else if (i % 397 == 20) {
+            uint32_t offset = i % 3 ? 50 : 0;
+            if (!checkView(name, graph, all, 1024, offset, 4)) {
+                return;
+            }
+            graph.setView(offset, 0);
+        }
+        if (i % 397 < 20) {
+            continue;
+        }
+        if (shownColumns(graph) != shownColumns(live)) {
+            CHECK_MSG(false, "%s sample %d: live columns differ after the view", name, i);
+            return;
+        }
+        if (i % 611 == 610 || i == 1023 || i == 1024) {
+            for (uint32_t offset : {0u, 1u, 5u, 64u, 333u, 900u, 1100u}) {
+                for (uint16_t spc : {1, 2, 3, 7, 8, 9, 64}) {
+                    if (!checkView(name, graph, all, 1024, offset, spc)) {
+                        return;
+                    }
+                    graph.setView(offset, 0);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    srand(15);
+    run<int16_t>("int16", 1, -500, 1000, false);
+    run<uint8_t>("uint8", 1, 0, 256, true);
+    run<int16_t>("int16 decimated", 3, 0, 300, false);
+    run<float>("float", 1, -100, 200, true);
+    return testResult("history");
+}
@@ -0,0 +1,64 @@
+//Clamping of inputValue() into the sample type range, for int and float input,
+//and values of the sample type itself stored without rounding.
+#include "test.h"
+
+static U8G2 display(128, 64, 8);
+
+template <typename T, typename V> void expect(const char *name, V input, double low, double high) {
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, 127, 63);
+    graph.inputValue(input);
+    CHECK_MSG(graph.getDataMin() == (float)low && graph.getDataMax() == (float)high, "%s input %g: %g %g, expected %g %g",
+              name, (double)input, graph.getDataMin(), graph.getDataMax(), low, high);
+}
+
+//Stream keeping the export, the newest value ends the last row.
+struct Sink : Stream {
+    std::string text;
+    size_t write(uint8_t c) override {
+        text += (char)c;
+        return 1;
+    }
+};
+
+template <typename T> void exact(const char *name, T input) {
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, 127, 63);
+    graph.inputValue(input);
+    Sink sink;
+    graph.exportStart(U8G2GRAPH_EXPORT_CSV);
+    while (graph.exportData(sink, 64)) {
+    }
+    std::string last = sink.text.substr(sink.text.rfind(',', sink.text.size() - 2) + 1);
+    CHECK_MSG(strtoll(last.c_str(), nullptr, 10) == (long long)input, "%s input %lld stored as %s", name, (long long)input,
+              last.c_str());
+}
+
+int main() {
+    expect<int8_t>("int8", 300, 0, 127);
+    expect<int8_t>("int8", -300, -128, 0);
+    expect<int8_t>("int8", -5, -5, 0);
+    expect<uint8_t>("uint8", -1, 0, 0);
+    expect<uint8_t>("uint8", 256, 0, 255);
+    expect<int16_t>("int16", 40000, 0, 32767);
+    expect<uint16_t>("uint16", 65535, 0, 65535);
+    expect<uint16_t>("uint16", -40000, 0, 0);
+    expect<int32_t>("int32", -2000000, -2000000, 0);
+    expect<uint32_t>("uint32", 70000, 0, 70000);
+    expect<uint32_t>("uint32", 2147483647, 0, 2147483647.0);
+    expect<uint32_t>("uint32", -5, 0, 0);
+    expect<uint8_t>("uint8", 300.0f, 0, 255);
+    expect<uint8_t>("uint8", -3.5f, 0, 0);
+    expect<int16_t>("int16", -1e9f, -32768, 0);
+    expect<uint32_t>("uint32", 1e12f, 0, 4294967295.0);
+    expect<float>("float", -7, -7, 0);
+    exact<uint32_t>("uint32", 3000000000UL);
+    exact<uint32_t>("uint32", 4294967295UL);
+    exact<int32_t>("int32", 123456789);
+    exact<int32_t>("int32", -2147483647L - 1);
+    exact<uint16_t>("uint16", 65535);
+    exact<int16_t>("int16", -32768);
+    exact<uint8_t>("uint8", 255);
+    exact<int8_t>("int8", -128);
+    return testResult("input");
+}
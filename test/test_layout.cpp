@@ -0,0 +1,98 @@
+//A graph whose Capacity or bufferSet() buffer holds fewer columns than its width
+//has to draw exactly as a graph begun that much narrower: plot, clip window,
+//axes and time labels follow the columns kept, nothing is drawn right of them.
+#include "test.h"
+#include <math.h>
+
+static U8G2 small(128, 64, 8);
+static U8G2 narrow(128, 64, 8);
+
+template <typename A, typename B> void compare(const char *name, A &graph, B &reference, uint16_t columns) {
+    CHECK_MSG(graph.getDataLen() == columns - 2, "%s: %u columns, expected %u", name, graph.getDataLen() + 2, columns);
+    for (int i = 0; i < 250; i++) {
+        g_micros += 20000;
+        g_millis = g_micros / 1000;
+        int16_t v = (int16_t)(sin(i * 0.1) * 400 + ((i % 37 == 0) ? 900 : 0));
+        graph.inputValue(v);
+        reference.inputValue(v);
+        if (i % 50 == 49) {
+            renderFrame(small, graph);
+            renderFrame(narrow, reference);
+            if (frameText(small) != frameText(narrow)) {
+                CHECK_MSG(false, "%s: frame after %d samples differs from a graph %u columns wide", name, i + 1,
+                          columns);
+                printf("%s\n%s", frameText(small).c_str(), frameText(narrow).c_str());
+                return;
+            }
+        }
+    }
+}
+
+template <typename A, typename B> void setup(A &graph, B &reference, uint16_t columns, uint16_t decim) {
+    graph.begin(4, 2, 120, 60);
+    reference.begin(4, 2, 4 + 20 + columns, 60);
+    graph.timeAxisSet(true);
+    reference.timeAxisSet(true);
+    graph.decimationSet(decim);
+    reference.decimationSet(decim);
+}
+
+//Envelope columns that fit in the bytes of a storage.
+static uint16_t envelopeColumns(size_t bytes) {
+    uint16_t columns = 0;
+    while (U8g2GraphingT<int16_t>::bytesNeeded(columns + 1, true) <= bytes) {
+        columns++;
+    }
+    return columns;
+}
+
+int main() {
+    {
+        U8g2GraphingT<int16_t, 60> graph(&small);
+        U8g2GraphingT<int16_t> reference(&narrow);
+        setup(graph, reference, 60, 1);
+        compare("Capacity 60", graph, reference, 60);
+    }
+    {
+        U8g2GraphingT<int16_t, 60> graph(&small);
+        U8g2GraphingT<int16_t> reference(&narrow);
+        uint16_t columns = envelopeColumns(U8g2GraphingT<int16_t>::bytesNeeded(60));
+        setup(graph, reference, columns, 4);
+        compare("Capacity 60 decimated", graph, reference, columns);
+    }
+
+    //A buffer sized for 50 plain columns holds fewer envelope columns.
+    static uint8_t storage[U8g2GraphingT<int16_t>::bytesNeeded(50)];
+    uint16_t envelope = envelopeColumns(sizeof(storage));
+    {
+        U8g2GraphingT<int16_t> graph(&small);
+        U8g2GraphingT<int16_t> reference(&narrow);
+        graph.bufferSet(storage, sizeof(storage));
+        setup(graph, reference, 50, 1);
+        compare("buffer of 50", graph, reference, 50);
+
+        U8g2GraphingT<int16_t> envelopes(&narrow);
+        envelopes.begin(4, 2, 4 + 20 + envelope, 60);
+        envelopes.timeAxisSet(true);
+        envelopes.decimationSet(3);
+        graph.decimationSet(3);
+        compare("buffer of 50 decimated", graph, envelopes, envelope);
+
+        U8g2GraphingT<int16_t> back(&narrow);
+        back.begin(4, 2, 4 + 20 + 50, 60);
+        back.timeAxisSet(true);
+        graph.decimationSet(1);
+        compare("buffer of 50 back to plain columns", graph, back, 50);
+    }
+
+    //Storage for the whole width keeps the geometry given to begin().
+    {
+        static uint8_t whole[U8g2GraphingT<int16_t>::bytesNeeded(96)];
+        U8g2GraphingT<int16_t> graph(&small);
+        U8g2GraphingT<int16_t> reference(&narrow);
+        graph.bufferSet(whole, sizeof(whole));
+        setup(graph, reference, 96, 1);
+        compare("buffer of the width", graph, reference, 96);
+    }
+    return testResult("layout");
+}
@@ -0,0 +1,70 @@
+//MIN and MAX markers while the graph fills up and after the ring wrapped,
+//against a scan of the filled columns only, the empty ones read nothing.
+#include "test.h"
+#include <deque>
+#include <utility>
+
+static U8G2 display(128, 64, 8);
+
+template <typename T> struct Peek : U8g2GraphingT<T> {
+    Peek() : U8g2GraphingT<T>(&display) {}
+    float value(uint8_t m) {
+        const U8g2GraphingReadout &r = this->markerreadout[m];
+        return (U8g2GraphingTraits<T>::isInteger) ? (float)r.valueint : r.value;
+    }
+};
+
+template <typename T> void run(const char *name, uint8_t series, uint16_t decim, int base, int spread) {
+    Peek<T> graph;
+    graph.begin(0, 0, 60, 63);
+    graph.seriesSet(series);
+    graph.decimationSet(decim);
+    graph.markerSet(0, U8G2GRAPH_MARKER_MIN);
+    graph.markerSet(1, U8G2GRAPH_MARKER_MAX);
+    uint16_t width = 60 - 20;
+    std::deque<std::pair<T, T>> columns;
+    for (int i = 0; i < 150; i++) {
+        T row[U8G2GRAPH_MAX_SERIES] = {};
+        for (uint8_t s = 0; s < series; s++) {
+            row[s] = (T)(base + rand() % spread);
+        }
+        graph.inputSeries(row);
+        T lo = row[0];
+        T hi = row[0];
+        for (uint8_t s = 1; s < series; s++) {
+            lo = (row[s] < lo) ? row[s] : lo;
+            hi = (row[s] > hi) ? row[s] : hi;
+        }
+        if (i % decim == 0) {
+            columns.push_back(std::make_pair(lo, hi));
+            if (columns.size() > width) {
+                columns.pop_front();
+            }
+        } else {
+            columns.back().first = (lo < columns.back().first) ? lo : columns.back().first;
+            columns.back().second = (hi > columns.back().second) ? hi : columns.back().second;
+        }
+        renderFrame(display, graph);
+        T mn = columns.front().first;
+        T mx = columns.front().second;
+        for (const auto &c : columns) {
+            mn = (c.first < mn) ? c.first : mn;
+            mx = (c.second > mx) ? c.second : mx;
+        }
+        if (graph.value(0) != (float)mn || graph.value(1) != (float)mx) {
+            CHECK_MSG(false, "%s series %u decim %u sample %d: markers %g %g, filled columns %g %g", name, series, decim, i,
+                      graph.value(0), graph.value(1), (float)mn, (float)mx);
+            return;
+        }
+    }
+}
+
+int main() {
+    srand(9);
+    run<uint8_t>("uint8", 1, 1, 200, 10);
+    run<int16_t>("int16", 1, 1, -300, 50);
+    run<int16_t>("int16", 3, 1, -300, 50);
+    run<int16_t>("int16", 2, 3, 100, 900);
+    run<float>("float", 2, 1, 50, 20);
+    return testResult("markers");
+}
@@ -0,0 +1,139 @@
+//Packed history round trip, random walks with large jumps through a small byte ring
+//that wraps and drops blocks. getHistoryLen() against a model of the block sizes,
+//the views against a scan of the samples and against a raw history of the same samples.
+#include "test.h"
+#include <deque>
+
+static U8G2 display(128, 64, 8);
+
+static uint64_t random64() {
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+//Bytes of a packed block, as packBlock() writes it.
+template <typename T> size_t blockSize(const std::vector<T> &all, size_t start) {
+    long long top = 0;
+    for (size_t i = start + 1; i < start + U8G2GRAPH_PACK_BLOCK; i++) {
+        long long d = (long long)all[i] - (long long)all[i - 1];
+        top |= (d < 0) ? ((-d) << 1) - 1 : d << 1;
+    }
+    uint8_t bits = 0;
+    while (top >> bits) {
+        bits++;
+    }
+    return 1 + 3 * sizeof(T) + (bits * (U8G2GRAPH_PACK_BLOCK - 1) + 7) / 8;
+}
+
+template <typename T>
+bool checkView(const char *name, U8g2GraphingT<T> &packed, U8g2GraphingT<T> &raw, const std::vector<T> &all,
+               uint32_t oldest, uint32_t offset, uint16_t spc) {
+    uint32_t total = all.size();
+    uint32_t end = total - ((offset < total) ? offset : total);
+    uint32_t first = (offset == 0 && end % spc) ? end % spc : spc;
+    uint16_t n = 0;
+    while (n < 107 && end >= oldest + first + (uint32_t)n * spc) {
+        n++;
+    }
+    packed.setView(offset, spc);
+    raw.setView(offset, spc);
+    std::vector<std::pair<long long, long long>> got = shownColumns(packed);
+    std::vector<std::pair<long long, long long>> other = shownColumns(raw);
+    packed.setView(0, 0);
+    raw.setView(0, 0);
+    if (got.size() != n || other.size() < n) {
+        CHECK_MSG(false, "%s offset %u zoom %u: %u columns, raw %u, expected %u", name, offset, spc, (unsigned)got.size(),
+                  (unsigned)other.size(), n);
+        return false;
+    }
+    for (uint16_t c = 0; c < n; c++) {
+        uint16_t back = n - 1 - c;
+        uint32_t from = end - first - (uint32_t)back * spc;
+        uint32_t to = from + (back ? spc : first);
+        long long lo = all[from];
+        long long hi = all[from];
+        for (uint32_t t = from; t < to; t++) {
+            lo = (all[t] < lo) ? all[t] : lo;
+            hi = (all[t] > hi) ? all[t] : hi;
+        }
+        if (got[c].first != lo || got[c].second != hi || got[c] != other[other.size() - n + c]) {
+            CHECK_MSG(false, "%s offset %u zoom %u samples %u..%u: %lld %lld, raw %lld %lld, scan %lld %lld", name, offset,
+                      spc, from, to, got[c].first, got[c].second, other[other.size() - n + c].first,
+                      other[other.size() - n + c].second, lo, hi);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T> void run(const char *name, size_t bytes, int step, bool callerBuffer) {
+    typedef U8g2GraphingTraits<T> Traits;
+    U8g2GraphingT<T> packed(&display);
+    U8g2GraphingT<T> raw(&display);
+    packed.begin(0, 0, 127, 63);
+    raw.begin(0, 0, 127, 63);
+    static uint64_t buffer[1024];
+    if (callerBuffer) {
+        packed.historyPackedSet(buffer, bytes);
+    } else {
+        packed.historyPackedSet(bytes);
+    }
+    raw.historySet(16384);
+    size_t room = bytes - U8G2GRAPH_PACK_BLOCK * sizeof(T);
+    std::deque<size_t> blocks;
+    size_t used = 0;
+    uint32_t dropped = 0;
+
+    std::vector<T> all;
+    long long lowest = (long long)Traits::lowest();
+    long long span = (long long)Traits::highest() - lowest;
+    long long v = lowest + span / 2;
+    for (int i = 0; i < 20000; i++) {
+        if (rand() % 40 == 0) {
+            v = lowest + (long long)(random64() % (uint64_t)(span + 1));
+        } else {
+            v += rand() % (2 * step + 1) - step;
+            v = (v < lowest) ? lowest : (v > lowest + span) ? lowest + span : v;
+        }
+        all.push_back((T)v);
+        g_micros += 1000;
+        g_millis = g_micros / 1000;
+        packed.inputValue((T)v);
+        raw.inputValue((T)v);
+
+        if (all.size() % U8G2GRAPH_PACK_BLOCK == 0) {
+            size_t need = blockSize(all, all.size() - U8G2GRAPH_PACK_BLOCK);
+            while (room - used < need) {
+                used -= blocks.front();
+                blocks.pop_front();
+                dropped++;
+            }
+            blocks.push_back(need);
+            used += need;
+        }
+        uint32_t oldest = dropped * U8G2GRAPH_PACK_BLOCK;
+        if (packed.getHistoryLen() != all.size() - oldest) {
+            CHECK_MSG(false, "%s sample %d: history of %u, expected %u", name, i, packed.getHistoryLen(),
+                      (unsigned)(all.size() - oldest));
+            return;
+        }
+        if (i % 2477 == 2476) {
+            for (uint32_t offset : {0u, 1u, 17u, 32u, 100u, 700u}) {
+                for (uint16_t spc : {1, 2, 3, 31, 32, 33, 100}) {
+                    if (!checkView(name, packed, raw, all, oldest, offset, spc)) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+    CHECK_MSG(dropped > 100, "%s dropped only %u blocks", name, dropped);
+}
+
+int main() {
+    srand(16);
+    run<int8_t>("int8", 300, 3, false);
+    run<uint16_t>("uint16", 700, 40, true);
+    run<int32_t>("int32", 2000, 100000, false);
+    run<uint32_t>("uint32", 1500, 5, true);
+    return testResult("pack");
+}
@@ -0,0 +1,94 @@
+//The fixed-point projection against the float one, every column of every
+//series within one pixel row, over random ranges, geometry and sample types.
+#include "test.h"
+
+static U8G2 display(128, 64, 8);
+
+template <typename T> struct Peek : U8g2GraphingT<T> {
+    Peek() : U8g2GraphingT<T>(&display) {}
+    u8g2_uint_t row(uint16_t i) { return this->graph[i]; }
+};
+
+template <typename T> void run(const char *name, bool asInt, float lo, float hi) {
+    for (int trial = 0; trial < 60; trial++) {
+        Peek<T> a, b;
+        int fy = rand() % 20;
+        int ty = fy + 20 + rand() % (63 - fy - 20 + 1);
+        bool xaxis = rand() % 2;
+        bool autorange = rand() % 3 == 0;
+        float vmin = lo + (hi - lo) * (rand() % 1000) / 2000.0f;
+        float vmax = vmin + (hi - vmin) * (1 + rand() % 1000) / 1000.0f;
+        if (asInt) {
+            a.beginInt(0, fy, 127, ty);
+            b.beginInt(0, fy, 127, ty);
+        } else {
+            a.begin(0, fy, 127, ty);
+            b.begin(0, fy, 127, ty);
+        }
+        b.projectionSet(true);
+        a.displaySet(xaxis);
+        b.displaySet(xaxis);
+        a.rangeSet(!autorange, vmin, vmax);
+        b.rangeSet(!autorange, vmin, vmax);
+        for (int i = 0; i < 150; i++) {
+            float v = lo + (hi - lo) * (rand() % 10000) / 10000.0f;
+            a.inputValue(v);
+            b.inputValue(v);
+        }
+        display.clearBuffer();
+        a.displayGraph();
+        b.displayGraph();
+        for (uint16_t i = 0; i < a.getDataLen(); i++) {
+            int d = (int)a.row(i) - (int)b.row(i);
+            if (d < -1 || d > 1) {
+                CHECK_MSG(false, "%s trial %d range %g to %g rows %d to %d column %u: float %d fixed %d", name, trial, vmin,
+                          vmax, fy, ty, i, a.row(i), b.row(i));
+                break;
+            }
+        }
+    }
+}
+
+//Ranges above 2^24, where the float range can not tell the values apart.
+//The integer projection has to spread them over the rows and survive a flat range.
+template <typename T> void large(const char *name, bool asInt, bool fixedpoint, long base, long step) {
+    for (int flat = 0; flat < 2; flat++) {
+        Peek<T> graph;
+        if (asInt) {
+            graph.beginInt(0, 0, 127, 63);
+        } else {
+            graph.begin(0, 0, 127, 63);
+        }
+        graph.projectionSet(fixedpoint);
+        for (int i = 0; i < 200; i++) {
+            graph.inputValue((T)(base + (flat ? 0 : i % 5 * step)));
+        }
+        display.clearBuffer();
+        graph.displayGraph();
+        u8g2_uint_t top = 63;
+        u8g2_uint_t bottom = 0;
+        for (uint16_t i = 0; i < graph.getDataLen(); i++) {
+            top = (graph.row(i) < top) ? graph.row(i) : top;
+            bottom = (graph.row(i) > bottom) ? graph.row(i) : bottom;
+        }
+        CHECK_MSG(flat ? top == bottom : top == 0 && bottom == 54, "%s %s %s: rows %d to %d", name,
+                  fixedpoint ? "fixed" : "float", flat ? "flat" : "ramp", top, bottom);
+    }
+}
+
+int main() {
+    srand(5);
+    run<float>("float", false, -1000, 1000);
+    run<float>("float", false, -0.01f, 0.02f);
+    run<float>("float int", true, -30000, 30000);
+    run<int16_t>("int16", false, -32768, 32767);
+    run<uint8_t>("uint8", false, 0, 255);
+    run<int32_t>("int32", false, -2e9f, 2e9f);
+    run<uint32_t>("uint32", false, 0, 4e9f);
+    large<int32_t>("int32", false, false, 100000000, 1);
+    large<int32_t>("int32", false, true, 100000000, 1);
+    large<int32_t>("int32", false, false, -2000000000, 1);
+    large<float>("float int", true, false, 100000000, 8);
+    large<float>("float int", true, true, 100000000, 8);
+    return testResult("projection");
+}
@@ -0,0 +1,69 @@
+//Golden frames of the legacy features (autorange, manual range, interval, stop,
+//start, clear, pointer, line and dotted styles, X axis) for a float and an
+//integer graph. The full buffer and the page buffer display have to agree.
+#include "test.h"
+
+static U8G2 fullDisplay(128, 64, 8);
+static U8G2 pageDisplay(128, 64, 1);
+
+static void run(std::string &out, bool isInt) {
+    U8g2Graphing full(&fullDisplay), page(&pageDisplay);
+    if (isInt) {
+        full.beginInt(0, 9, 127, 63);
+        page.beginInt(0, 9, 127, 63);
+    } else {
+        full.begin(0, 9, 127, 63);
+        page.begin(0, 9, 127, 63);
+    }
+    U8g2Graphing *graphs[2] = {&full, &page};
+    for (int step = 0; step < 400; step++) {
+        g_millis += 7;
+        g_micros += 7000;
+        float v = sin(step * 0.07) * 100 + (step % 37 == 0 ? 60 : 0);
+        int style = (step / 50) % 4;
+        for (U8g2Graphing *g : graphs) {
+            g->displaySet(style < 2, style & 1);
+            g->pointerSet(step % 3 != 0, (step * 13) % 500);
+            if (step == 250) {
+                g->rangeSet(true, -50, 150);
+            }
+            if (step == 300) {
+                g->rangeSet(false);
+                g->intervalSet(20);
+            }
+            if (step == 340) {
+                g->stop();
+            }
+            if (step == 360) {
+                g->start();
+                g->intervalSet(0);
+            }
+            if (step == 380) {
+                g->clearData();
+            }
+            g->inputValue(v);
+        }
+        if (step % 10 != 9) {
+            continue;
+        }
+        renderFrame(fullDisplay, full);
+        renderFrame(pageDisplay, page);
+        CHECK_MSG(fullDisplay.frame == pageDisplay.frame, "int %d step %d", isInt, step);
+        char line[160];
+        snprintf(line, sizeof(line), "step %d int %d min %g max %g dmin %g dmax %g len %u crc %08X\n", step, isInt,
+                 full.getMin(), full.getMax(), full.getDataMin(), full.getDataMax(), full.getDataLen(),
+                 (unsigned)crc32(fullDisplay.frame.data(), fullDisplay.frame.size()));
+        out += line;
+        if (step % 100 == 49) {
+            out += frameText(fullDisplay);
+        }
+    }
+}
+
+int main() {
+    std::string out;
+    run(out, false);
+    run(out, true);
+    CHECK(matchGolden("render.txt", out));
+    return testResult("render");
+}
@@ -0,0 +1,61 @@
+//drawSpans() writing straight into the tile buffer against the drawLine() path,
+//forced by a horizontal buffer layout, over random geometry and page heights.
+#include "test.h"
+#include <math.h>
+
+static void drawPages(U8G2 &display, U8g2GraphingT<int16_t> &graph) {
+    display.firstPage();
+    do {
+        graph.displayGraph();
+    } while (display.nextPage());
+}
+
+int main() {
+    srand(3);
+    const int pageRows[] = {1, 2, 8};
+    for (int trial = 0; trial < 240; trial++) {
+        int rows = pageRows[trial % 3];
+        U8G2 spans(128, 64, rows);
+        U8G2 lines(128, 64, rows);
+        lines.st.ll_hvline = u8g2_ll_hvline_horizontal_right_lsb;
+        int fx = rand() % 40;
+        int fy = rand() % 20;
+        int tx = fx + 40 + rand() % (127 - fx - 40 + 1);
+        int ty = fy + 25 + rand() % (63 - fy - 25 + 1);
+        bool xaxis = rand() % 2;
+        bool dotted = rand() % 4 == 0;
+        uint8_t series = 1 + rand() % 3;
+        uint16_t decim = (rand() % 4 == 0) ? 1 + rand() % 4 : 1;
+
+        U8g2GraphingT<int16_t> a(&spans);
+        U8g2GraphingT<int16_t> b(&lines);
+        a.begin(fx, fy, tx, ty);
+        b.begin(fx, fy, tx, ty);
+        a.displaySet(xaxis, dotted);
+        b.displaySet(xaxis, dotted);
+        a.seriesSet(series);
+        b.seriesSet(series);
+        a.decimationSet(decim);
+        b.decimationSet(decim);
+
+        int n = rand() % 300;
+        for (int i = 0; i < n; i++) {
+            int16_t row[3];
+            for (uint8_t s = 0; s < series; s++) {
+                row[s] = (rand() % 5 == 0) ? rand() % 1000 : (int16_t)(sin(i * 0.2 + s) * 300);
+            }
+            a.inputSeries(row);
+            b.inputSeries(row);
+            if (i % 97 == 0 || i == n - 1) {
+                drawPages(spans, a);
+                drawPages(lines, b);
+                if (spans.frame != lines.frame) {
+                    CHECK_MSG(false, "trial %d page rows %d: %d,%d to %d,%d series %u decim %u sample %d differs", trial,
+                              rows, fx, fy, tx, ty, series, decim, i);
+                    break;
+                }
+            }
+        }
+    }
+    return testResult("spans");
+}
@@ -0,0 +1,53 @@
+//Column time stamps: the 16-bit encoding of the time between columns and the
+//X axis labels of graphs whose span no longer fits 32 bits of µs.
+#include "test.h"
+
+struct Peek : U8g2GraphingT<int16_t> {
+    Peek(U8G2 *display) : U8g2GraphingT<int16_t>(display) {}
+    static uint32_t roundTrip(uint32_t us) { return decodeStamp(encodeStamp(us)); }
+    const char *far() { return farlabel; }
+    const char *mid() { return midlabel; }
+};
+
+static void step(uint32_t us) {
+    g_micros += us;
+    g_millis = g_micros / 1000;
+}
+
+//Feed samples at a fixed interval and compare the far and middle labels.
+static void labels(uint16_t width, uint32_t intervalMs, int samples, const char *far, const char *mid) {
+    U8G2 display(width, 64, 8);
+    Peek graph(&display);
+    graph.begin(0, 0, width - 1, 63);
+    graph.displaySet(true);
+    graph.intervalSet(intervalMs);
+    for (int i = 0; i < samples; i++) {
+        step(intervalMs * 1000);
+        graph.inputValue(i % 20);
+    }
+    renderFrame(display, graph);
+    CHECK_MSG(!strcmp(graph.far(), far) && !strcmp(graph.mid(), mid), "width %u interval %lu ms: labels %s %s, expected %s %s",
+              width, (unsigned long)intervalMs, graph.far(), graph.mid(), far, mid);
+}
+
+int main() {
+    //Exact in µs, within 1 ms in the ms range, within 0.5 s above, saturated at 4294 s.
+    for (uint64_t us = 0; us < 5000000000ULL; us += (us < 100000) ? 1 : (us < 100000000) ? 997 : 999983) {
+        uint32_t in = (us < 0xFFFFFFFFULL) ? (uint32_t)us : 0xFFFFFFFFUL;
+        uint32_t out = Peek::roundTrip(in);
+        double err = (double)in - (double)out;
+        bool ok = (in < 32768) ? err == 0 : (in < 16384000UL) ? err >= 0 && err < 1000 : (in < 4294000000UL) ? err >= -500000 && err <= 500000 : out == 4294000000UL;
+        if (!ok) {
+            CHECK_MSG(false, "stamp %lu decodes to %lu", (unsigned long)in, (unsigned long)out);
+            break;
+        }
+    }
+
+    //107 columns, 106 intervals of a minute, and a graph of 459 columns whose
+    //458 minutes no longer fit 32 bits of µs.
+    labels(128, 60000, 120, "6360", "3180");
+    labels(480, 60000, 500, "27480", "13740");
+    labels(128, 1000, 200, "106", "53");
+    labels(128, 20, 200, "2120", "1060");
+    return testResult("stamps");
+}
@@ -0,0 +1,72 @@
+//Mean, standard deviation and peak to peak of the first series over the filled
+//columns, against a scan of the samples, while filling and after the wrap.
+#include "test.h"
+#include <deque>
+#include <math.h>
+#include <utility>
+
+static U8G2 display(128, 64, 8);
+
+static bool near(double a, double b) {
+    return fabs(a - b) <= 1e-3 * (fabs(b) + 1);
+}
+
+template <typename T> void run(const char *name, uint8_t series, uint16_t decim, int base, int spread) {
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, 60, 63);
+    graph.seriesSet(series);
+    graph.decimationSet(decim);
+    uint16_t width = 60 - 20;
+    std::deque<std::pair<T, T>> columns;
+    for (int i = 0; i < 150; i++) {
+        T row[U8G2GRAPH_MAX_SERIES] = {};
+        for (uint8_t s = 0; s < series; s++) {
+            row[s] = (T)(base + rand() % spread + 1000 * s);
+        }
+        graph.inputSeries(row);
+        if (i % decim == 0) {
+            columns.push_back(std::make_pair(row[0], row[0]));
+            if (columns.size() > width) {
+                columns.pop_front();
+            }
+        } else {
+            columns.back().first = (row[0] < columns.back().first) ? row[0] : columns.back().first;
+            columns.back().second = (row[0] > columns.back().second) ? row[0] : columns.back().second;
+        }
+        double sum = 0;
+        double sq = 0;
+        T lo = columns.front().first;
+        T hi = columns.front().second;
+        for (const auto &c : columns) {
+            double v = (decim > 1) ? ((double)c.first + (double)c.second) / 2 : (double)c.second;
+            sum += v;
+            sq += v * v;
+            lo = (c.first < lo) ? c.first : lo;
+            hi = (c.second > hi) ? c.second : hi;
+        }
+        double mean = sum / columns.size();
+        double dev = sqrt(fmax(sq / columns.size() - mean * mean, 0));
+        if (!near(graph.getMean(), mean) || !near(graph.getStdDev(), dev) || graph.getPeakToPeak() != (float)(hi - lo)) {
+            CHECK_MSG(false, "%s series %u decim %u sample %d: mean %g sd %g pp %g, scan %g %g %g", name, series, decim, i,
+                      graph.getMean(), graph.getStdDev(), graph.getPeakToPeak(), mean, dev, (double)(hi - lo));
+            return;
+        }
+    }
+}
+
+int main() {
+    U8g2GraphingT<uint8_t> graph(&display);
+    graph.begin(0, 0, 127, 63);
+    for (int i = 0; i < 10; i++) {
+        graph.inputValue(200 + i);
+    }
+    CHECK(graph.getMean() == 204.5f);
+    CHECK(graph.getPeakToPeak() == 9);
+
+    srand(4);
+    run<uint8_t>("uint8", 1, 1, 200, 10);
+    run<int16_t>("int16", 3, 1, -300, 50);
+    run<int16_t>("int16", 2, 3, 100, 900);
+    run<float>("float", 2, 1, 50, 20);
+    return testResult("stats");
+}
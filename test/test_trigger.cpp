@@ -0,0 +1,173 @@
+//Triggered capture against a model of the trigger, rising and falling edges with
+//hysteresis, the pre-trigger columns, decimation, the pushFromISR()/update() path
+//and the freeze, the captured screen has to hold the columns around the trigger.
+#include "test.h"
+#include <math.h>
+
+static U8G2 display(128, 64, 8);
+
+enum Feed { FEED_VALUE, FEED_ISR };
+
+//Sample index starting the capture and the trigger column of the model,
+//or -1 if it did not fire.
+struct Capture {
+    long trigger;
+    long column;
+};
+
+//The trigger as described by triggerSet(), over the samples from the arming on.
+//Columns are counted from the first sample of the graph, every decim samples.
+template <typename T>
+Capture model(const std::vector<T> &all, size_t armed, uint16_t decim, bool rising, float fire, float prime,
+              uint16_t pre, uint16_t width) {
+    uint16_t count = 0;
+    bool primed = false;
+    for (size_t i = armed; i < all.size(); i++) {
+        bool fresh = (i % decim == 0) || i == armed;
+        if (fresh && count < width) {
+            count++;
+        }
+        if (rising ? all[i] < prime : all[i] > prime) {
+            primed = true;
+        } else if (primed && count > pre && (rising ? all[i] >= fire : all[i] <= fire)) {
+            return Capture{(long)i, (long)(i / decim)};
+        }
+    }
+    return Capture{-1, -1};
+}
+
+template <typename T>
+void run(const char *name, uint16_t decim, Feed feed, U8g2GraphingTrigger edge, float level, float hysteresis,
+         float pretrigger) {
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, 127, 63);
+    graph.decimationSet(decim);
+    if (feed == FEED_ISR) {
+        graph.queueSet(16);
+    }
+    const uint16_t width = 107;
+    bool rising = (edge == U8G2GRAPH_TRIGGER_RISING);
+    uint16_t pre = (uint16_t)(pretrigger * (width - 1) + 0.5f);
+    std::vector<T> all;
+    size_t armed = 0;
+    for (int shot = 0; shot < 4; shot++) {
+        graph.triggerSet(edge, level, hysteresis, pretrigger);
+        armed = all.size();
+        //A slow wave around the level with noise, whole numbers so the export reads them back exactly.
+        int phase = rand() % 500;
+        for (int n = 0; n < 4000 && !graph.isTriggered(); n++) {
+            T v = (T)floor(sin((n + phase) * 0.05) * 40 + level + rand() % 5 - 2);
+            all.push_back(v);
+            g_micros += 100;
+            g_millis = g_micros / 1000;
+            if (feed == FEED_ISR) {
+                graph.pushFromISR(v, g_micros);
+                if (n % 5 == 4) {
+                    graph.update();
+                }
+            } else {
+                graph.inputValue(v);
+            }
+        }
+        if (feed == FEED_ISR) {
+            graph.update();
+        }
+        Capture want = model(all, armed, decim, rising, rising ? ceil(level) : floor(level),
+                             rising ? level - hysteresis : level + hysteresis, pre, width);
+        if (!graph.isTriggered() || want.trigger < 0) {
+            CHECK_MSG(false, "%s decim %u shot %d: triggered %d, model %ld", name, decim, shot, graph.isTriggered(),
+                      want.trigger);
+            return;
+        }
+        CHECK_MSG(want.column - (long)(armed / decim) >= pre, "%s shot %d: trigger before the pre-trigger columns", name,
+                  shot);
+
+        //The screen holds pre columns before the trigger column and the rest after it.
+        std::vector<std::pair<long long, long long>> got = shownColumns(graph);
+        long firstcol = want.column - pre;
+        bool same = (got.size() == width);
+        for (uint16_t c = 0; same && c < width; c++) {
+            size_t from = (size_t)(firstcol + c) * decim;
+            long long lo = (long long)all[from];
+            long long hi = lo;
+            for (size_t t = from; t < from + decim && t < all.size(); t++) {
+                lo = ((long long)all[t] < lo) ? (long long)all[t] : lo;
+                hi = ((long long)all[t] > hi) ? (long long)all[t] : hi;
+            }
+            same = (got[c].first == lo && got[c].second == hi);
+        }
+        CHECK_MSG(same, "%s decim %u shot %d: captured columns differ from %ld..%ld", name, decim, shot, firstcol,
+                  firstcol + width - 1);
+
+        //Frozen, later samples are dropped until the next arming.
+        for (int k = 0; k < 300; k++) {
+            if (feed == FEED_ISR) {
+                graph.pushFromISR((T)(level + 30), k);
+                graph.update();
+            } else {
+                graph.inputValue((T)(level + 30));
+            }
+        }
+        CHECK_MSG(graph.isTriggered() && shownColumns(graph) == got, "%s decim %u shot %d: capture not frozen", name,
+                  decim, shot);
+        renderFrame(display, graph);
+
+        //The next shot starts on an empty graph, its columns counted from its first sample.
+        graph.clearData();
+        all.clear();
+    }
+}
+
+int main() {
+    srand(24);
+
+    //Pre-trigger 0.25 of 107 columns puts the trigger at column 27, 79 columns after it.
+    {
+        U8g2GraphingT<int16_t> graph(&display);
+        graph.begin(0, 0, 127, 63);
+        graph.triggerSet(U8G2GRAPH_TRIGGER_RISING, 10, 5, 0.25f);
+        int n = 0;
+        for (; n < 60; n++) {
+            graph.inputValue((int16_t)0);
+        }
+        graph.inputValue((int16_t)10);
+        CHECK(!graph.isTriggered());
+        for (n = 0; n < 78; n++) {
+            graph.inputValue((int16_t)20);
+        }
+        CHECK(!graph.isTriggered());
+        graph.inputValue((int16_t)20);
+        CHECK(graph.isTriggered());
+        std::vector<std::pair<long long, long long>> got = shownColumns(graph);
+        CHECK(got.size() == 107 && got[26].second == 0 && got[27].second == 10 && got[28].second == 20);
+    }
+
+    //The hysteresis: a signal that never goes below level - hysteresis never fires.
+    {
+        U8g2GraphingT<int16_t> graph(&display);
+        graph.begin(0, 0, 127, 63);
+        graph.triggerSet(U8G2GRAPH_TRIGGER_RISING, 10, 5, 0);
+        for (int n = 0; n < 1000; n++) {
+            graph.inputValue((int16_t)(n % 2 ? 6 : 14));
+        }
+        CHECK(!graph.isTriggered());
+        graph.inputValue((int16_t)4);
+        graph.inputValue((int16_t)10);
+        for (int n = 0; n < 106; n++) {
+            graph.inputValue((int16_t)14);
+        }
+        CHECK(graph.isTriggered());
+        std::vector<std::pair<long long, long long>> got = shownColumns(graph);
+        CHECK(got.size() == 107 && got[0].second == 10 && got[106].second == 14);
+    }
+
+    for (uint16_t decim : {1, 3}) {
+        for (Feed feed : {FEED_VALUE, FEED_ISR}) {
+            run<int16_t>("int16 rising", decim, feed, U8G2GRAPH_TRIGGER_RISING, 10, 5, 0.25f);
+            run<int16_t>("int16 falling", decim, feed, U8G2GRAPH_TRIGGER_FALLING, -10.5f, 8, 0.7f);
+            run<float>("float rising", decim, feed, U8G2GRAPH_TRIGGER_RISING, 2.5f, 3, 0);
+            run<float>("float falling", decim, feed, U8G2GRAPH_TRIGGER_FALLING, 0, 4, 1);
+        }
+    }
+    return testResult("trigger");
+}
@@ -0,0 +1,81 @@
+//The monotonic min/max queues of the autorange against a brute force scan of the
+//window, with single samples, rows of several series, blocks and decimated
+//columns, whose newest column is widened by the samples merged into it.
+#include "test.h"
+#include <deque>
+#include <utility>
+
+static U8G2 display(128, 64, 8);
+
+template <typename T> void run(const char *name, uint16_t tox, uint8_t series, uint16_t decim, int mode) {
+    U8g2GraphingT<T> graph(&display);
+    graph.begin(0, 0, tox, 63);
+    graph.seriesSet(series);
+    graph.decimationSet(decim);
+    uint16_t width = tox - 20;
+
+    //Column extremes over every series, the ring starts filled with zeros.
+    std::deque<std::pair<T, T>> window(width, std::make_pair((T)0, (T)0));
+    uint16_t fill = 0;
+    srand(tox * 31 + series * 7 + decim + mode);
+    for (int i = 0; i < 6000; i++) {
+        if (i == 3000) {
+            graph.clearData();
+            window.assign(width, std::make_pair((T)0, (T)0));
+            fill = 0;
+        }
+        T row[U8G2GRAPH_MAX_SERIES] = {};
+        for (uint8_t s = 0; s < series; s++) {
+            int r = rand() % 7;
+            row[s] = (T)(r == 0 ? i % 50 : r == 1 ? 40 - i % 50 : rand() % 200 - 90);
+        }
+        if (mode == 0 && series == 1) {
+            graph.inputValue((int)row[0]);
+        } else if (mode == 1 && series == 1) {
+            graph.inputValues(row, 1, 100);
+        } else {
+            graph.inputSeries(row);
+        }
+        T lo = row[0];
+        T hi = row[0];
+        for (uint8_t s = 1; s < series; s++) {
+            lo = (row[s] < lo) ? row[s] : lo;
+            hi = (row[s] > hi) ? row[s] : hi;
+        }
+        if (fill == 0) {
+            window.pop_front();
+            window.push_back(std::make_pair(lo, hi));
+        } else {
+            window.back().first = (lo < window.back().first) ? lo : window.back().first;
+            window.back().second = (hi > window.back().second) ? hi : window.back().second;
+        }
+        fill = (fill + 1 >= decim) ? 0 : fill + 1;
+
+        T mn = window.front().first;
+        T mx = window.front().second;
+        for (const auto &c : window) {
+            mn = (c.first < mn) ? c.first : mn;
+            mx = (c.second > mx) ? c.second : mx;
+        }
+        if ((float)mn != graph.getDataMin() || (float)mx != graph.getDataMax()) {
+            CHECK_MSG(false, "%s width %u series %u decim %u mode %d sample %d: %g %g, scan %g %g", name, width, series,
+                      decim, mode, i, graph.getDataMin(), graph.getDataMax(), (float)mn, (float)mx);
+            return;
+        }
+    }
+}
+
+int main() {
+    for (uint16_t tox = 25; tox < 160; tox += 37) {
+        for (int mode = 0; mode < 3; mode++) {
+            for (uint16_t decim = 1; decim <= 5; decim += 4) {
+                uint8_t series = (mode == 2) ? 3 : 1;
+                run<float>("float", tox, series, decim, mode);
+                run<int16_t>("int16", tox, series, decim, mode);
+                run<int8_t>("int8", tox, series, decim, mode);
+            }
+        }
+        run<float>("float", tox, 4, 3, 2);
+    }
+    return testResult("window");
+}